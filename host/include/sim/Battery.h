@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef _SIM_BATTERY_H_
+#define _SIM_BATTERY_H_
+
+namespace sim {
+
+/**
+ * Model of the V5 battery: an open-circuit voltage that falls linearly with charge,
+ * behind a small internal resistance, so the voltage sags under load and drifts down
+ * over the course of a match.
+ */
+class Battery {
+
+  public:
+
+    Battery();
+
+    // Terminal voltage at the current load.
+    double voltage() const;
+
+    // Remaining charge, 0...1.
+    double charge() const;
+
+    // Draw `current` amps for `dt` seconds.
+    void step(double current, double dt);
+
+    // Set the state of charge, 0...1.
+    void setCharge(double charge);
+
+    // Physical parameters; public so that tools can vary them.
+    double capacity, fullVoltage, emptyVoltage, resistance, idleCurrent;
+
+  private:
+
+    double remaining, load;
+};
+
+}
+
+#endif
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "sim/Motor.h"
+
+#ifndef _SIM_CHASSIS_H_
+#define _SIM_CHASSIS_H_
+
+namespace sim {
+
+/**
+ * Model of the mecanum drive base: four direct-driven wheels, each with its own
+ * traction force against the floor, pushing a rigid body around the field.
+ *
+ * Each wheel's contact patch has an "ideal" surface speed given by the body's motion
+ * through the usual mecanum kinematics.  The difference between that and the wheel's
+ * actual surface speed is the slip, and the traction force is a smoothed Coulomb
+ * friction of the slip, capped at mu * (weight / 4).  Hard accelerations and twists
+ * therefore slip just like on carpet.
+ *
+ * Wheels are indexed front-left, front-right, back-left, back-right, the same order as
+ * `MecanumDriveTank`'s mixer.  Speeds are physical (positive rolls the robot forwards);
+ * the right-side motors are mounted reversed.
+ *
+ * The robot tips when the wheels push it along harder than its weight can hold it
+ * down: `tipping` is the ratio of the two, about whichever wheel axle or side the
+ * robot is tipping towards, so anything over 1 would have gone over.  It depends on
+ * `cgHeight`, which the world keeps up to date as the lift moves.
+ *
+ * The pose is in field coordinates: x and y in metres, and heading in radians,
+ * clockwise from the +y axis.
+ */
+class Chassis {
+
+  public:
+
+    Chassis();
+
+    /**
+     * Attach the four wheel motors, in the order front-left, front-right, back-left,
+     * back-right.
+     */
+    void attach(Motor* fl, Motor* fr, Motor* bl, Motor* br);
+
+    // Advance by one time step of `dt` seconds.
+    void step(double supply, double dt);
+
+    // Put the robot somewhere on the field, at rest.
+    void place(double x, double y, double heading);
+
+    // Pose and body-frame velocities (forward, right, clockwise).
+    double x, y, heading;
+    double forwardSpeed, strafeSpeed, turnSpeed;
+
+    // Height of the centre of mass (m), the tipping ratio on the last step, and the
+    // largest it has been.
+    double cgHeight, tipping, worstTipping;
+
+    // Per-wheel speed (rad/s) and slip (m/s, wheel surface minus ideal).
+    double wheelSpeed[4];
+    double slip[4];
+
+    // Physical parameters; public so that tools can vary them.
+    double mass, inertia, wheelRadius, halfTrack, halfBase, mu, slipSpeed, rollingDrag;
+
+    // Which way each wheel rolls (+1/-1) when the robot strafes right.
+    double strafeSign[4];
+
+    // Direction of each motor relative to its wheel.
+    double motorSign[4];
+
+    // Each wheel's share of `mu` (1 everywhere by default), for putting one wheel on
+    // a slippery patch.
+    double grip[4];
+
+  private:
+
+    Motor* motors[4];
+    double wheelAngle[4];
+
+    // Field-frame velocity, which is what actually gets integrated.
+    double vx, vy, omega;
+};
+
+}
+
+#endif
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "sim/Motor.h"
+
+#ifndef _SIM_INTAKE_H_
+#define _SIM_INTAKE_H_
+
+namespace sim {
+
+/**
+ * Model of the roller intake: two independent rollers with some inertia and friction.
+ * The left roller turns forwards to intake and the right one backwards.
+ *
+ * A cube can be put in the rollers to add load, or the rollers can be jammed, which
+ * stalls them outright.
+ */
+class Intake {
+
+  public:
+
+    Intake();
+
+    // Attach the two roller motors.
+    void attach(Motor* left, Motor* right);
+
+    // Advance by one time step of `dt` seconds.
+    void step(double supply, double dt);
+
+    // Roller angles and speeds (rad, rad/s), left then right.
+    double angle[2], speed[2];
+
+    // Extra torque (Nm) resisting each roller while a cube is in the intake.
+    double cubeLoad;
+
+    // While true, the rollers can't turn at all.
+    bool jammed;
+
+    // Physical parameters; public so that tools can vary them.
+    double inertia, friction;
+
+  private:
+
+    Motor* motors[2];
+};
+
+}
+
+#endif
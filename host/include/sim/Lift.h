@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "sim/Motor.h"
+
+#ifndef _SIM_LIFT_H_
+#define _SIM_LIFT_H_
+
+namespace sim {
+
+/**
+ * Model of the RD4B lift as a single joint, driven by two motors through an external
+ * reduction and pulled down by gravity acting on the load at the top of the lift.
+ *
+ * The joint angle is measured from the floor position, so it is zero at the bottom
+ * hard stop and `travel` at the top one.  The left motor turns forwards to raise the
+ * lift and the right motor, mounted mirrored, turns backwards.
+ *
+ * Hitting either hard stop stops the lift dead; the speed it was going at the time is
+ * recorded so that tools can check for the lift being slammed.
+ */
+class Lift {
+
+  public:
+
+    Lift();
+
+    // Attach the two lift motors.
+    void attach(Motor* left, Motor* right);
+
+    // Advance by one time step of `dt` seconds.
+    void step(double supply, double dt);
+
+    // Height of the load above its floor position, in metres.
+    double height() const;
+
+    // Joint angle and speed (rad, rad/s).
+    double angle, speed;
+
+    // Largest speed (rad/s) the lift has hit a hard stop at, and how many times.
+    double worstImpact;
+    int32_t impacts;
+
+    // Physical parameters; public so that tools can vary them.
+    double gearing, travel, armLength, restAngle, load, armInertia, friction;
+
+  private:
+
+    Motor* left;
+    Motor* right;
+};
+
+}
+
+#endif
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+
+#ifndef _SIM_MOTOR_H_
+#define _SIM_MOTOR_H_
+
+namespace sim {
+
+/**
+ * What a `Motor` does when it is stopped, mirroring `vex::brakeType`.
+ */
+enum class Brake {
+  COAST,  // Windings left open; the shaft spins freely.
+  BRAKE,  // Windings shorted; back-EMF resists motion but nothing holds position.
+  HOLD    // Internal position loop holds the shaft where it stopped.
+};
+
+/**
+ * Model of a single V5 smart motor, in output shaft units (radians, rad/s, Nm) after
+ * the gear cartridge.
+ *
+ * Electrically this is a DC motor with the V5's 2.5A current limit; the constants are
+ * fitted to the published torque/speed curves (free speed and stall torque per
+ * cartridge at 12V) rather than being physically consistent.  On top of that sits a
+ * model of the motor's own firmware: the velocity loop used by `spin()`, the position
+ * loop used by `startRotateTo()`, direct voltage, and the three brake modes.  Like
+ * the real motor, "direct voltage" is a duty cycle: the commanded voltage is taken as
+ * a fraction of 12V and applied to whatever the battery is giving.
+ *
+ * A motor doesn't integrate its own shaft unless nothing is attached to it; otherwise
+ * the mechanism it drives calls `torque()` to get the output torque, integrates, and
+ * writes the new shaft state back with `setShaft()`.
+ */
+class Motor {
+
+  public:
+
+    Motor();
+
+    /**
+     * Swap the gear cartridge.
+     *
+     * @param
+     *    ratio - Internal gear ratio, i.e. 36 (100rpm), 18 (200rpm) or 6 (600rpm).
+     */
+    void setCartridge(double ratio);
+
+    // Commands, as sent by the stand-in `vex::motor`.
+    void commandVoltage(double volts);
+    void commandVelocity(double speed);
+    void commandPosition(double angle, double maxSpeed);
+    void commandStop(Brake mode);
+
+    /**
+     * Runs the firmware control loops against the current shaft state and returns the
+     * torque on the output shaft.  Also updates current, voltage and temperature.
+     *
+     * @param
+     *    supply - Battery voltage available to the motor.
+     *    dt - Time step, in seconds.
+     */
+    double torque(double supply, double dt);
+
+    // Called by the mechanism that drives this motor once it has integrated.
+    void setShaft(double angle, double speed);
+
+    /**
+     * Integrates the shaft against the motor's own rotor inertia.  Used for ports with
+     * nothing modelled on the other end.
+     */
+    void stepFree(double supply, double dt);
+
+    // Send the motor's measured velocity to the brain.  Called every _SIM_WORLD_REPORT.
+    void report();
+
+    // Encoder zeroing, as for `vex::motor::resetPosition()`.
+    void resetEncoder();
+
+    // Free speed and stall torque at 12V for the current cartridge.
+    double maxSpeed() const;
+    double stallTorque() const;
+
+    // Inertia of the rotor as seen at the output shaft.
+    double rotorInertia() const;
+
+    // Sensor values.  Angles are relative to the last `resetEncoder()`.
+    double getAngle() const;
+    double getSpeed() const;
+    double getReportedSpeed() const;    // as last sent to the brain
+    double getCurrent() const;
+    double getVoltage() const;
+    double getTorque() const;
+    double getTemperature() const;
+    double getRatio() const;
+    bool isDone() const;
+
+    // Signed current drawn at the terminals on the last step; used for battery drain.
+    double getSupplyCurrent() const;
+
+    // Whether some mechanism owns the shaft of this motor.
+    bool attached;
+
+    // Number of commands received so far, for benchmarking.
+    uint32_t commands;
+
+  private:
+
+    enum Mode { VOLTAGE, VELOCITY, POSITION, STOPPED };
+
+    // Firmware velocity loop; returns the terminal voltage.
+    double velocityLoop(double target, double dt);
+
+    double ratio;
+    Mode mode;
+    Brake brake;
+    double target, maxTarget, holdAngle, integral;
+
+    double angle, speed, offset, reportedSpeed;
+    double current, voltage, outputTorque, temperature, supplyCurrent;
+    bool done;
+};
+
+}
+
+#endif
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "sim/Motor.h"
+#include "sim/Chassis.h"
+#include "sim/Lift.h"
+#include "sim/Intake.h"
+#include "sim/Battery.h"
+#include <stdint.h>
+
+#ifndef _SIM_WORLD_H_
+#define _SIM_WORLD_H_
+
+// The number of smart ports on the brain.
+#define _SIM_WORLD_PORTS 21
+
+// Length of one physics step, in microseconds.
+#define _SIM_WORLD_STEP 1000
+
+// Time between motors sending their measured velocity to the brain, in microseconds.
+#define _SIM_WORLD_REPORT 10000
+
+// Height of the centre of mass of the robot without the lift's load, and of the load
+// with the lift all the way down, in metres.
+#define _SIM_WORLD_BASE_CG 0.1
+#define _SIM_WORLD_LOAD_CG 0.15
+
+namespace sim {
+
+/**
+ * Buttons on a simulated controller, in the order they are stored.
+ */
+enum Button { L1, L2, R1, R2, UP, DOWN, LEFT, RIGHT, X, B, Y, A, BUTTON_COUNT };
+
+/**
+ * Everything the stand-in controller reads.  Tools write to this to feed input traces
+ * into the robot code.
+ */
+struct Controller {
+  int32_t axis[4];            // Axis1...Axis4, -100...100
+  bool button[BUTTON_COUNT];
+};
+
+/**
+ * Running totals of what has been drawn on the brain screen.  The stand-in screen
+ * only counts; tools reset these around a frame to see what it would have cost.
+ */
+struct Screen {
+  uint32_t calls;             // drawing calls made
+  uint64_t pixels;            // pixels those calls would have written
+};
+
+/**
+ * What the brain keeps for each port on behalf of `vex::motor`.  On the host this lives
+ * in the world rather than in the handle, so that threads running their own worlds
+ * against the same shared handles (see `Motors`) don't share it too.
+ */
+struct MotorSettings {
+  double velocity;            // percent, for spin() and startRotateTo() without one
+  Brake stopping;             // for stop() without a brake mode
+};
+
+/**
+ * A complete simulated robot: one `Motor` per smart port, the mechanisms wired to
+ * them according to `RobotMap.h`, the battery, the controllers and the clock.
+ *
+ * The stand-in `vex` classes in `host/include/v5_vcs.h` all talk to the *current*
+ * world of the calling thread, so every thread can run its own fully independent
+ * simulation.  Time only moves when someone calls `advance()`, which is also what
+ * `task::sleep()` and `wait()` do on the host; runs are deterministic and go as fast
+ * as the physics can be stepped.
+ */
+class World {
+
+  public:
+
+    /**
+     * Builds the robot described by `RobotMap.h`, at rest with everything zeroed and a
+     * full battery.
+     */
+    World();
+
+    // Make this the world that the stand-in `vex` classes on this thread talk to.
+    void makeCurrent();
+
+    /**
+     * Returns the current world of this thread.  If `makeCurrent()` was never called on
+     * this thread, a default world is created for it.
+     */
+    static World& current();
+
+    // Run the physics for `ms` milliseconds, in fixed _SIM_WORLD_STEP increments.
+    void advance(uint32_t ms);
+
+    // Time since the world was created.
+    uint64_t micros() const;
+
+    // The motor plugged into a port (0-based, as with the PORTn constants).
+    Motor& motor(int32_t port);
+
+    Chassis chassis;
+    Lift lift;
+    Intake intake;
+    Battery battery;
+    Controller controllers[2];
+    Screen screen;
+
+    // Brain-side settings of each port's motor, indexed as for `motor()`.
+    MotorSettings settings[_SIM_WORLD_PORTS];
+
+    // Host directory that stands in for the SD card, or nullptr for no card inserted.
+    const char* sdcard;
+
+  private:
+
+    // One physics step.
+    void step();
+
+    Motor motors[_SIM_WORLD_PORTS];
+    uint64_t time;
+};
+
+}
+
+#endif
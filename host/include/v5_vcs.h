@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * Host stand-in for the parts of the V5 SDK's C++ API (`v5_vcs.h`) that the robot code
+ * uses.  Names and signatures follow the SDK, so the code in `src/` builds unchanged
+ * with a desktop compiler.
+ *
+ * Instead of talking to hardware, every device here reads and writes the current
+ * `sim::World` of the calling thread (see `host/include/sim/World.h`).  Devices only
+ * remember which port they are on, so copies of a `motor` share state just like they
+ * do on the robot.
+ *
+ * Waiting (`task::sleep()`, `wait()`, `this_thread::sleep_for()`) advances the
+ * simulated clock instead of blocking.  `task`s are recorded but never started; host
+ * tools drive the loops themselves.
+ */
+#ifndef _HOST_V5_VCS_H_
+#define _HOST_V5_VCS_H_
+
+#include <stdint.h>
+#include <mutex>
+
+namespace vex {
+
+  enum class percentUnits     { pct };
+  enum class velocityUnits    { pct, rpm, dps };
+  enum class rotationUnits    { deg, rev, raw };
+  enum class timeUnits        { sec, msec };
+  enum class voltageUnits     { volt, mV };
+  enum class currentUnits     { amp };
+  enum class powerUnits       { watt };
+  enum class torqueUnits      { Nm, InLb };
+  enum class temperatureUnits { celsius, fahrenheit };
+  enum class brakeType        { coast, brake, hold, undefined };
+  enum class directionType    { fwd, rev, undefined };
+  enum class gearSetting      { ratio36_1, ratio18_1, ratio6_1 };
+  enum class controllerType   { primary, partner };
+
+  const percentUnits     percent = percentUnits::pct;
+  const timeUnits        msec    = timeUnits::msec;
+  const timeUnits        seconds = timeUnits::sec;
+  const directionType    forward = directionType::fwd;
+  const directionType    reverse = directionType::rev;
+  const voltageUnits     volt    = voltageUnits::volt;
+  const velocityUnits    rpm     = velocityUnits::rpm;
+  const rotationUnits    degrees = rotationUnits::deg;
+  const rotationUnits    turns   = rotationUnits::rev;
+  const currentUnits     amp     = currentUnits::amp;
+  const temperatureUnits celsius = temperatureUnits::celsius;
+  const brakeType        coast   = brakeType::coast;
+  const brakeType        brake   = brakeType::brake;
+  const brakeType        hold    = brakeType::hold;
+  const controllerType   primary = controllerType::primary;
+  const controllerType   partner = controllerType::partner;
+
+  /**
+   * V5 smart motor on a smart port.
+   */
+  class motor {
+    public:
+      motor(int32_t index);
+      motor(int32_t index, bool reverse);
+      motor(int32_t index, gearSetting gears);
+      motor(int32_t index, gearSetting gears, bool reverse);
+
+      int32_t index();
+      bool installed();
+
+      void setReversed(bool value);
+      void setVelocity(double velocity, velocityUnits units);
+      void setVelocity(double velocity, percentUnits units);
+      void setBrake(brakeType mode);
+      void setStopping(brakeType mode);
+      void setMaxTorque(double value, percentUnits units);
+      void setTimeout(int32_t time, timeUnits units);
+
+      void resetRotation();
+      void resetPosition();
+      void setRotation(double value, rotationUnits units);
+      void setPosition(double value, rotationUnits units);
+
+      void spin(directionType dir);
+      void spin(directionType dir, double velocity, velocityUnits units);
+      void spin(directionType dir, double velocity, percentUnits units);
+      void spin(directionType dir, double voltage, voltageUnits units);
+
+      bool rotateTo(double rotation, rotationUnits units, bool waitForCompletion = true);
+      bool startRotateTo(double rotation, rotationUnits units);
+      bool startRotateTo(double rotation, rotationUnits units, double velocity, velocityUnits units_v);
+      bool rotateFor(double rotation, rotationUnits units, bool waitForCompletion = true);
+      bool startRotateFor(double rotation, rotationUnits units);
+
+      void stop();
+      void stop(brakeType mode);
+
+      bool isSpinning();
+      bool isDone();
+
+      double rotation(rotationUnits units);
+      double position(rotationUnits units);
+      double velocity(velocityUnits units);
+      double velocity(percentUnits units);
+      double current(currentUnits units = currentUnits::amp);
+      double current(percentUnits units);
+      double voltage(voltageUnits units = voltageUnits::volt);
+      double power(powerUnits units = powerUnits::watt);
+      double torque(torqueUnits units = torqueUnits::Nm);
+      double efficiency(percentUnits units = percentUnits::pct);
+      double temperature(percentUnits units);
+      double temperature(temperatureUnits units);
+
+    private:
+      int32_t port;
+      bool reversed;
+  };
+
+  /**
+   * Stopwatch measured against the simulated clock.
+   */
+  class timer {
+    public:
+      timer();
+      double time();
+      double time(timeUnits units);
+      double value();
+      void clear();
+      static uint32_t system();
+      static uint64_t systemHighResolution();
+    private:
+      uint64_t start;
+  };
+
+  /**
+   * Tasks are recorded but never run on the host.
+   */
+  class task {
+    public:
+      static const int32_t taskPrioritylow    = 1;
+      static const int32_t taskPriorityNormal = 7;
+      static const int32_t taskPriorityHigh   = 15;
+
+      task();
+      task(int (*callback)(void));
+      task(int (*callback)(void), int32_t priority);
+      task(int (*callback)(void*), void* arg);
+      task(int (*callback)(void*), void* arg, int32_t priority);
+
+      void stop();
+      void suspend();
+      void resume();
+      int32_t priority();
+      void setPriority(int32_t priority);
+
+      static void sleep(uint32_t time);
+      static void yield();
+
+    private:
+      int32_t taskPriority;
+  };
+
+  namespace this_thread {
+    void sleep_for(uint32_t time);
+    void yield();
+  }
+
+  void wait(double time, timeUnits units);
+
+  /**
+   * A real mutex on the host, since tools run robot code on several threads at once.
+   */
+  class mutex {
+    public:
+      void lock();
+      bool try_lock();
+      void unlock();
+    private:
+      std::mutex handle;
+  };
+
+  /**
+   * V5 controller.  Reads from the current world's `sim::Controller`.
+   */
+  class controller {
+    public:
+      controller();
+      controller(controllerType id);
+
+      class axis {
+        public:
+          axis(int32_t controllerId, int32_t index);
+          int32_t value();
+          int32_t position();
+          int32_t position(percentUnits units);
+        private:
+          int32_t controllerId, index;
+      };
+
+      class button {
+        public:
+          button(int32_t controllerId, int32_t index);
+          bool pressing();
+        private:
+          int32_t controllerId, index;
+      };
+
+      class lcd {
+        public:
+          void setCursor(int32_t row, int32_t col);
+          void print(const char* format, ...);
+          void clearScreen();
+          void clearLine();
+          void clearLine(int32_t number);
+          void newLine();
+      };
+
+      void rumble(const char* pattern);
+      bool installed();
+
+      axis Axis1, Axis2, Axis3, Axis4;
+      button ButtonL1, ButtonL2, ButtonR1, ButtonR2,
+             ButtonUp, ButtonDown, ButtonLeft, ButtonRight,
+             ButtonX, ButtonB, ButtonY, ButtonA;
+      lcd Screen;
+
+    private:
+      int32_t id;
+  };
+
+  /**
+   * Competition control.  On the host nothing is ever called back; tools call the
+   * autonomous and driver control functions themselves.
+   */
+  class competition {
+    public:
+      void autonomous(void (*callback)(void));
+      void drivercontrol(void (*callback)(void));
+      bool isEnabled();
+      bool isDriverControl();
+      bool isAutonomous();
+      bool isCompetitionSwitch();
+      bool isFieldControl();
+  };
+
+  /**
+   * Colours for the brain screen.  Stored but never displayed on the host.
+   */
+  class color {
+    public:
+      color();
+      color(uint32_t value);
+      uint32_t rgb() const;
+
+      static const color black;
+      static const color white;
+      static const color red;
+      static const color green;
+      static const color blue;
+      static const color yellow;
+      static const color orange;
+
+    private:
+      uint32_t value;
+  };
+
+  /**
+   * The V5 brain.  The battery, SD card and timer are backed by the simulation; the
+   * screen draws nothing but adds up what each call would cost in `sim::World::screen`.
+   */
+  class brain {
+    public:
+      class lcd {
+        public:
+          void setPenColor(const color& value);
+          void setFillColor(const color& value);
+          void clearScreen();
+          void clearScreen(const color& value);
+          void drawRectangle(int32_t x, int32_t y, int32_t width, int32_t height);
+          void drawLine(int32_t x1, int32_t y1, int32_t x2, int32_t y2);
+          void printAt(int32_t x, int32_t y, const char* format, ...);
+          void render();
+      };
+
+      class battery {
+        public:
+          double voltage(voltageUnits units = voltageUnits::volt);
+          double current(currentUnits units = currentUnits::amp);
+          uint32_t capacity(percentUnits units = percentUnits::pct);
+      };
+
+      class sdcard {
+        public:
+          bool isInserted();
+          bool exists(const char* name);
+          int32_t size(const char* name);
+          int32_t loadfile(const char* name, uint8_t* buffer, int32_t len);
+          int32_t savefile(const char* name, uint8_t* buffer, int32_t len);
+          int32_t appendfile(const char* name, uint8_t* buffer, int32_t len);
+      };
+
+      battery Battery;
+      lcd Screen;
+      sdcard SDcard;
+      timer Timer;
+  };
+
+}
+
+#endif
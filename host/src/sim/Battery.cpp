@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "sim/Battery.h"
+
+namespace sim {
+
+// 1100mAh, 12.8V when full; the brain itself draws a little on top of the motors.
+Battery::Battery() {
+  this->capacity = 1.1 * 3600;
+  this->fullVoltage = 12.8;
+  this->emptyVoltage = 11.2;
+  this->resistance = 0.1;
+  this->idleCurrent = 0.3;
+  this->remaining = this->capacity;
+  this->load = 0;
+}
+
+double Battery::charge() const {
+  return this->remaining / this->capacity;
+}
+
+void Battery::setCharge(double charge) {
+  this->remaining = charge * this->capacity;
+}
+
+double Battery::voltage() const {
+  double open = this->emptyVoltage + (this->fullVoltage - this->emptyVoltage) * this->charge();
+  return open - this->resistance * this->load;
+}
+
+void Battery::step(double current, double dt) {
+  this->load = current + this->idleCurrent;
+  this->remaining -= this->load * dt;
+  if(this->remaining < 0) this->remaining = 0;
+}
+
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "sim/Chassis.h"
+#include <math.h>
+
+#define _SIM_CHASSIS_GRAVITY 9.81
+
+namespace sim {
+
+// Which way each wheel rolls for a clockwise turn: left side forwards, right side back.
+static const double turnSign[4] = { +1, -1, +1, -1 };
+
+/*
+ * Defaults are for our robot: about 7kg with the lift, 4" mecanum wheels on green
+ * cartridges.  The strafe signs are whatever makes the mixer in `MecanumDriveTank`
+ * strafe, given how our wheels are mounted.
+ */
+Chassis::Chassis() {
+  this->mass = 7.0;
+  this->inertia = 0.25;
+  this->wheelRadius = 0.0508;
+  this->halfTrack = 0.17;
+  this->halfBase = 0.15;
+  this->mu = 0.7;
+  this->slipSpeed = 0.05;
+  this->rollingDrag = 2.0;
+  this->cgHeight = 0.1;
+  this->tipping = this->worstTipping = 0;
+  const double strafe[4] = { +1, +1, -1, -1 };
+  const double motor[4] = { +1, -1, +1, -1 };
+  for(int i = 0; i < 4; i++) {
+    this->strafeSign[i] = strafe[i];
+    this->motorSign[i] = motor[i];
+    this->grip[i] = 1;
+    this->motors[i] = nullptr;
+    this->wheelSpeed[i] = 0;
+    this->wheelAngle[i] = 0;
+    this->slip[i] = 0;
+  }
+  this->place(0, 0, 0);
+}
+
+void Chassis::attach(Motor* fl, Motor* fr, Motor* bl, Motor* br) {
+  Motor* motors[4] = { fl, fr, bl, br };
+  for(int i = 0; i < 4; i++) {
+    this->motors[i] = motors[i];
+    motors[i]->attached = true;
+  }
+}
+
+void Chassis::place(double x, double y, double heading) {
+  this->x = x;
+  this->y = y;
+  this->heading = heading;
+  this->vx = this->vy = this->omega = 0;
+  this->forwardSpeed = this->strafeSpeed = this->turnSpeed = 0;
+}
+
+void Chassis::step(double supply, double dt) {
+  double s = sin(this->heading), c = cos(this->heading);
+  double lever = this->halfTrack + this->halfBase;
+  double normal = this->mass * _SIM_CHASSIS_GRAVITY / 4;
+
+  // Body-frame velocity from the field-frame state.
+  this->forwardSpeed = this->vx * s + this->vy * c;
+  this->strafeSpeed  = this->vx * c - this->vy * s;
+  this->turnSpeed    = this->omega;
+
+  double force = 0, side = 0, torque = 0;
+  for(int i = 0; i < 4; i++) {
+    Motor* motor = this->motors[i];
+    if(motor == nullptr) continue;
+
+    double ideal = this->forwardSpeed
+                 + this->strafeSign[i] * this->strafeSpeed
+                 + turnSign[i] * lever * this->turnSpeed;
+    this->slip[i] = this->wheelSpeed[i] * this->wheelRadius - ideal;
+    double traction = this->grip[i] * this->mu * normal * tanh(this->slip[i] / this->slipSpeed);
+
+    // Wheel: motor torque in, traction and a little bearing friction out.
+    double wheelInertia = motor->rotorInertia() + 2.5e-4;
+    double drive = this->motorSign[i] * motor->torque(supply, dt);
+    this->wheelSpeed[i] += dt * (drive - traction * this->wheelRadius - 1e-3 * this->wheelSpeed[i])
+                              / wheelInertia;
+    this->wheelAngle[i] += dt * this->wheelSpeed[i];
+    motor->setShaft(this->motorSign[i] * this->wheelAngle[i], this->motorSign[i] * this->wheelSpeed[i]);
+
+    force  += traction;
+    side   += this->strafeSign[i] * traction;
+    torque += turnSign[i] * lever * traction;
+  }
+
+  // Tipping forwards or backwards pivots on an axle, and sideways on the wheels of
+  // one side; the traction forces act at floor level, a long way below the mass.
+  double forwardTip = fabs(force) * this->cgHeight / (this->mass * _SIM_CHASSIS_GRAVITY * this->halfBase);
+  double sideTip = fabs(side) * this->cgHeight / (this->mass * _SIM_CHASSIS_GRAVITY * this->halfTrack);
+  this->tipping = forwardTip > sideTip ? forwardTip : sideTip;
+  if(this->tipping > this->worstTipping) this->worstTipping = this->tipping;
+
+  // Integrate the body in the field frame.
+  double fx = force * s + side * c - this->rollingDrag * this->vx;
+  double fy = force * c - side * s - this->rollingDrag * this->vy;
+  this->vx += dt * fx / this->mass;
+  this->vy += dt * fy / this->mass;
+  this->omega += dt * (torque - 0.1 * this->omega) / this->inertia;
+  this->x += dt * this->vx;
+  this->y += dt * this->vy;
+  this->heading += dt * this->omega;
+}
+
+}
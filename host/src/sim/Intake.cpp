@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "sim/Intake.h"
+#include <math.h>
+
+namespace sim {
+
+Intake::Intake() {
+  this->cubeLoad = 0;
+  this->jammed = false;
+  this->inertia = 4e-4;
+  this->friction = 5e-3;
+  this->motors[0] = this->motors[1] = nullptr;
+  for(int i = 0; i < 2; i++) this->angle[i] = this->speed[i] = 0;
+}
+
+void Intake::attach(Motor* left, Motor* right) {
+  this->motors[0] = left;
+  this->motors[1] = right;
+  left->attached = true;
+  right->attached = true;
+}
+
+void Intake::step(double supply, double dt) {
+  for(int i = 0; i < 2; i++) {
+    Motor* motor = this->motors[i];
+    if(motor == nullptr) continue;
+    double torque = motor->torque(supply, dt);
+    if(this->jammed) {
+      this->speed[i] = 0;
+    } else {
+      // The cube load always opposes whichever way the roller is turning.
+      double load = this->friction * this->speed[i];
+      if(this->speed[i] != 0) load += (this->speed[i] > 0 ? 1 : -1) * this->cubeLoad;
+      double inertia = this->inertia + motor->rotorInertia();
+      this->speed[i] += dt * (torque - load) / inertia;
+    }
+    this->angle[i] += dt * this->speed[i];
+    motor->setShaft(this->angle[i], this->speed[i]);
+  }
+}
+
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "sim/Lift.h"
+#include <math.h>
+
+#define _SIM_LIFT_GRAVITY 9.81
+
+namespace sim {
+
+/*
+ * Defaults are for our lift: 25cm bars on each stage, 7:1 external reduction, and
+ * about 2kg of intake (plus cube) riding on top.  The bars start 40 degrees below
+ * horizontal and can swing through about 115 degrees.
+ */
+Lift::Lift() {
+  this->gearing = 7;
+  this->travel = 2.0;
+  this->armLength = 0.25;
+  this->restAngle = -0.7;
+  this->load = 2.0;
+  this->armInertia = 0.05;
+  this->friction = 0.3;
+  this->angle = this->speed = 0;
+  this->worstImpact = 0;
+  this->impacts = 0;
+  this->left = this->right = nullptr;
+}
+
+void Lift::attach(Motor* left, Motor* right) {
+  this->left = left;
+  this->right = right;
+  left->attached = true;
+  right->attached = true;
+}
+
+double Lift::height() const {
+  return 2 * this->armLength * (sin(this->restAngle + this->angle) - sin(this->restAngle));
+}
+
+void Lift::step(double supply, double dt) {
+  if(this->left == nullptr || this->right == nullptr) return;
+
+  double phi = this->restAngle + this->angle;
+  double reach = 2 * this->armLength * cos(phi);
+
+  // Two stages double the lever arm of the load about the bottom joint.
+  double motors = this->gearing * (this->left->torque(supply, dt) - this->right->torque(supply, dt));
+  double gravity = this->load * _SIM_LIFT_GRAVITY * reach;
+  double rotors = (this->left->rotorInertia() + this->right->rotorInertia()) * this->gearing * this->gearing;
+  double inertia = this->load * reach * reach + this->armInertia + rotors;
+
+  this->speed += dt * (motors - gravity - this->friction * this->speed) / inertia;
+  this->angle += dt * this->speed;
+
+  // Hard stops at either end of travel.
+  if((this->angle <= 0 && this->speed < 0) || (this->angle >= this->travel && this->speed > 0)) {
+    if(fabs(this->speed) > this->worstImpact) this->worstImpact = fabs(this->speed);
+    this->impacts++;
+    this->speed = 0;
+  }
+  if(this->angle < 0) this->angle = 0;
+  if(this->angle > this->travel) this->angle = this->travel;
+
+  this->left->setShaft(this->gearing * this->angle, this->gearing * this->speed);
+  this->right->setShaft(-this->gearing * this->angle, -this->gearing * this->speed);
+}
+
+}
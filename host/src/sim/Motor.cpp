@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "sim/Motor.h"
+#include <math.h>
+
+// Characteristics of the bare V5 motor, before the cartridge.
+#define _SIM_MOTOR_BASE_RPM 3600.0
+#define _SIM_MOTOR_BASE_INERTIA 2.0e-6
+#define _SIM_MOTOR_NOMINAL_VOLTS 12.0
+#define _SIM_MOTOR_CURRENT_LIMIT 2.5
+
+// Stall torque of the 18:1 (green) cartridge, which the other cartridges scale from.
+#define _SIM_MOTOR_GREEN_STALL 1.05
+
+// Winding resistance used for heating, and the thermal mass and resistance to ambient.
+#define _SIM_MOTOR_HEAT_OHMS 1.2
+#define _SIM_MOTOR_THERMAL_MASS 60.0
+#define _SIM_MOTOR_THERMAL_RESISTANCE 2.0
+#define _SIM_MOTOR_AMBIENT 25.0
+
+// Gains of the firmware loops, relative to the motor's back-EMF constant.
+#define _SIM_MOTOR_VELOCITY_KP 2.0
+#define _SIM_MOTOR_VELOCITY_KI 10.0
+#define _SIM_MOTOR_POSITION_KP 8.0
+
+// How close, in radians at the output, a position move has to get to count as done.
+#define _SIM_MOTOR_POSITION_TOLERANCE 0.01
+
+namespace sim {
+
+static double clamp(double value, double limit) {
+  if(value > limit) return limit;
+  if(value < -limit) return -limit;
+  return value;
+}
+
+Motor::Motor() {
+  this->attached = false;
+  this->commands = 0;
+  this->ratio = 18;
+  this->mode = STOPPED;
+  this->brake = Brake::COAST;
+  this->target = this->maxTarget = this->holdAngle = this->integral = 0;
+  this->angle = this->speed = this->offset = this->reportedSpeed = 0;
+  this->current = this->voltage = this->outputTorque = this->supplyCurrent = 0;
+  this->temperature = _SIM_MOTOR_AMBIENT;
+  this->done = true;
+}
+
+void Motor::setCartridge(double ratio) {
+  this->ratio = ratio;
+}
+
+double Motor::maxSpeed() const {
+  return _SIM_MOTOR_BASE_RPM / this->ratio * 2 * M_PI / 60;
+}
+
+double Motor::stallTorque() const {
+  return _SIM_MOTOR_GREEN_STALL * this->ratio / 18;
+}
+
+double Motor::rotorInertia() const {
+  return _SIM_MOTOR_BASE_INERTIA * this->ratio * this->ratio;
+}
+
+void Motor::commandVoltage(double volts) {
+  this->commands++;
+  this->mode = VOLTAGE;
+  this->target = volts;
+  this->done = true;
+}
+
+void Motor::commandVelocity(double speed) {
+  this->commands++;
+  if(this->mode != VELOCITY) this->integral = 0;
+  this->mode = VELOCITY;
+  this->target = speed;
+  this->done = true;
+}
+
+// Positions come in relative to the encoder zero, but are held in raw shaft angle.
+void Motor::commandPosition(double angle, double maxSpeed) {
+  this->commands++;
+  if(this->mode != POSITION || this->target != angle + this->offset) {
+    this->done = false;
+    if(this->mode != POSITION) this->integral = 0;
+  }
+  this->mode = POSITION;
+  this->target = angle + this->offset;
+  this->maxTarget = fabs(maxSpeed);
+}
+
+void Motor::commandStop(Brake mode) {
+  this->commands++;
+  if(this->mode != STOPPED || this->brake != mode) {
+    this->holdAngle = this->angle;
+    this->integral = 0;
+  }
+  this->mode = STOPPED;
+  this->brake = mode;
+  this->done = true;
+}
+
+/*
+ * Feedforward on back-EMF plus PI, which is roughly what the motor firmware does.  The
+ * integrator is clamped so that it can never ask for more than full voltage by itself.
+ */
+double Motor::velocityLoop(double target, double dt) {
+  double ke = _SIM_MOTOR_NOMINAL_VOLTS / this->maxSpeed();
+  double error = target - this->speed;
+  this->integral = clamp(this->integral + error * dt,
+                         _SIM_MOTOR_NOMINAL_VOLTS / (_SIM_MOTOR_VELOCITY_KI * ke));
+  return ke * target
+       + _SIM_MOTOR_VELOCITY_KP * ke * error
+       + _SIM_MOTOR_VELOCITY_KI * ke * this->integral;
+}
+
+double Motor::torque(double supply, double dt) {
+  double maxVolts = supply < _SIM_MOTOR_NOMINAL_VOLTS ? supply : _SIM_MOTOR_NOMINAL_VOLTS;
+  double volts = 0;
+  bool open = false;
+
+  switch(this->mode) {
+    case VOLTAGE:  volts = this->target * supply / _SIM_MOTOR_NOMINAL_VOLTS;
+                   break;
+    case VELOCITY: volts = this->velocityLoop(this->target, dt);
+                   break;
+    case POSITION: {
+      double error = this->target - this->angle;
+      volts = this->velocityLoop(clamp(_SIM_MOTOR_POSITION_KP * error, this->maxTarget), dt);
+      if(fabs(error) < _SIM_MOTOR_POSITION_TOLERANCE) this->done = true;
+      break;
+    }
+    case STOPPED:
+      if(this->brake == Brake::COAST) {
+        open = true;
+      } else if(this->brake == Brake::HOLD) {
+        double error = this->holdAngle - this->angle;
+        volts = this->velocityLoop(clamp(_SIM_MOTOR_POSITION_KP * error, this->maxSpeed()), dt);
+      }
+      break;
+  }
+  volts = clamp(volts, maxVolts);
+
+  // The firmware cuts the current limit as the motor heats up: 50% at 55C, down to
+  // nothing at 70C.
+  double limit = _SIM_MOTOR_CURRENT_LIMIT;
+  if(this->temperature >= 70) limit = 0;
+  else if(this->temperature >= 65) limit *= 0.125;
+  else if(this->temperature >= 60) limit *= 0.25;
+  else if(this->temperature >= 55) limit *= 0.5;
+
+  double ke = _SIM_MOTOR_NOMINAL_VOLTS / this->maxSpeed();
+  double kt = this->stallTorque() / _SIM_MOTOR_CURRENT_LIMIT;
+  double resistance = _SIM_MOTOR_NOMINAL_VOLTS / _SIM_MOTOR_CURRENT_LIMIT;
+  double amps = open ? 0 : clamp((volts - ke * this->speed) / resistance, limit);
+
+  this->voltage = open ? 0 : volts;
+  this->current = amps;
+  this->outputTorque = kt * amps;
+  this->supplyCurrent = (supply > 0 && volts * amps > 0) ? volts * amps / supply : 0;
+  this->temperature += dt * ( amps * amps * _SIM_MOTOR_HEAT_OHMS
+                            - (this->temperature - _SIM_MOTOR_AMBIENT) / _SIM_MOTOR_THERMAL_RESISTANCE )
+                          / _SIM_MOTOR_THERMAL_MASS;
+  return this->outputTorque;
+}
+
+void Motor::setShaft(double angle, double speed) {
+  this->angle = angle;
+  this->speed = speed;
+}
+
+void Motor::stepFree(double supply, double dt) {
+  // Nothing to do for an empty port that has cooled off, which is most of them.
+  if(this->mode == STOPPED && this->brake == Brake::COAST && this->speed == 0
+     && this->temperature - _SIM_MOTOR_AMBIENT < 0.01) {
+    this->current = this->voltage = this->outputTorque = this->supplyCurrent = 0;
+    return;
+  }
+  double torque = this->torque(supply, dt) - 1e-4 * this->speed;
+  this->speed += dt * torque / this->rotorInertia();
+  this->angle += dt * this->speed;
+}
+
+void Motor::report() {
+  this->reportedSpeed = this->speed;
+}
+
+void Motor::resetEncoder() {
+  this->offset = this->angle;
+}
+
+double Motor::getAngle() const { return this->angle - this->offset; }
+double Motor::getSpeed() const { return this->speed; }
+double Motor::getReportedSpeed() const { return this->reportedSpeed; }
+double Motor::getCurrent() const { return fabs(this->current); }
+double Motor::getVoltage() const { return this->voltage; }
+double Motor::getTorque() const { return this->outputTorque; }
+double Motor::getTemperature() const { return this->temperature; }
+double Motor::getRatio() const { return this->ratio; }
+double Motor::getSupplyCurrent() const { return this->supplyCurrent; }
+bool Motor::isDone() const { return this->done; }
+
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "vex.h"
+#include "sim/World.h"
+
+namespace sim {
+
+// The world each thread is running against; see `World::current()`.
+static thread_local World* active = nullptr;
+
+World::World() {
+  this->time = 0;
+  this->sdcard = nullptr;
+  this->screen.calls = 0;
+  this->screen.pixels = 0;
+  for(int i = 0; i < 2; i++) {
+    for(int j = 0; j < 4; j++) this->controllers[i].axis[j] = 0;
+    for(int j = 0; j < BUTTON_COUNT; j++) this->controllers[i].button[j] = false;
+  }
+  for(int i = 0; i < _SIM_WORLD_PORTS; i++) {
+    this->settings[i].velocity = 50;
+    this->settings[i].stopping = Brake::COAST;
+  }
+
+  this->chassis.attach( &this->motor(FRONT_LEFT_MOTOR_PORT),
+                        &this->motor(FRONT_RIGHT_MOTOR_PORT),
+                        &this->motor(BACK_LEFT_MOTOR_PORT),
+                        &this->motor(BACK_RIGHT_MOTOR_PORT) );
+  this->lift.attach(&this->motor(LIFT_LEFT_MOTOR_PORT), &this->motor(LIFT_RIGHT_MOTOR_PORT));
+  this->intake.attach(&this->motor(ROLLER_LEFT_MOTOR_PORT), &this->motor(ROLLER_RIGHT_MOTOR_PORT));
+}
+
+void World::makeCurrent() {
+  active = this;
+}
+
+World& World::current() {
+  if(active == nullptr) {
+    static thread_local World fallback;
+    active = &fallback;
+  }
+  return *active;
+}
+
+Motor& World::motor(int32_t port) {
+  return this->motors[port];
+}
+
+uint64_t World::micros() const {
+  return this->time;
+}
+
+void World::advance(uint32_t ms) {
+  uint64_t end = this->time + (uint64_t) ms * 1000;
+  while(this->time < end) this->step();
+}
+
+/*
+ * Every motor works off the battery voltage from the end of the last step, and the
+ * battery then sees the total current they drew.
+ */
+void World::step() {
+  double dt = _SIM_WORLD_STEP * 1e-6;
+  double supply = this->battery.voltage();
+
+  // The load on top of the lift carries the centre of mass up with it.
+  double load = this->lift.load;
+  this->chassis.cgHeight = ( (this->chassis.mass - load) * _SIM_WORLD_BASE_CG
+                           + load * (_SIM_WORLD_LOAD_CG + this->lift.height()) ) / this->chassis.mass;
+
+  this->chassis.step(supply, dt);
+  this->lift.step(supply, dt);
+  this->intake.step(supply, dt);
+
+  double current = 0;
+  for(int i = 0; i < _SIM_WORLD_PORTS; i++) {
+    if(!this->motors[i].attached) this->motors[i].stepFree(supply, dt);
+    current += this->motors[i].getSupplyCurrent();
+  }
+  this->battery.step(current, dt);
+  this->time += _SIM_WORLD_STEP;
+
+  if(this->time % _SIM_WORLD_REPORT == 0) {
+    for(int i = 0; i < _SIM_WORLD_PORTS; i++) this->motors[i].report();
+  }
+}
+
+}
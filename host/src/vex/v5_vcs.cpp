@@ -0,0 +1,481 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "v5_vcs.h"
+#include "sim/World.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <algorithm>
+
+/*
+ * Everything in here forwards to `sim::World::current()`.  Motors keep only their port
+ * and reversal; the rest of what the real `vex::motor` keeps on the brain side (the
+ * velocity used by `spin()`, and the brake mode used by `stop()`) lives in the world's
+ * `settings`, with everything else.
+ */
+
+namespace vex {
+
+static sim::Motor& simMotor(int32_t port) {
+  return sim::World::current().motor(port);
+}
+
+static sim::MotorSettings& settings(int32_t port) {
+  return sim::World::current().settings[port];
+}
+
+static double percentToSpeed(sim::Motor& motor, double percent) {
+  return motor.maxSpeed() * percent / 100;
+}
+
+static sim::Brake toBrake(brakeType mode) {
+  switch(mode) {
+    case brakeType::brake: return sim::Brake::BRAKE;
+    case brakeType::hold:  return sim::Brake::HOLD;
+    default:               return sim::Brake::COAST;
+  }
+}
+
+// Encoder ticks per output revolution; 50 per unit of cartridge ratio (900 for green).
+static double toRadians(sim::Motor& motor, double value, rotationUnits units) {
+  switch(units) {
+    case rotationUnits::deg: return value * M_PI / 180;
+    case rotationUnits::rev: return value * 2 * M_PI;
+    default:                 return value / (50 * motor.getRatio()) * 2 * M_PI;
+  }
+}
+
+static double fromRadians(sim::Motor& motor, double value, rotationUnits units) {
+  switch(units) {
+    case rotationUnits::deg: return value * 180 / M_PI;
+    case rotationUnits::rev: return value / (2 * M_PI);
+    default:                 return value / (2 * M_PI) * (50 * motor.getRatio());
+  }
+}
+
+/*
+ * motor
+ */
+motor::motor(int32_t index) : motor(index, gearSetting::ratio18_1, false) {}
+motor::motor(int32_t index, bool reverse) : motor(index, gearSetting::ratio18_1, reverse) {}
+motor::motor(int32_t index, gearSetting gears) : motor(index, gears, false) {}
+
+motor::motor(int32_t index, gearSetting gears, bool reverse) {
+  this->port = index;
+  this->reversed = reverse;
+  settings(index).velocity = 50;
+  settings(index).stopping = sim::Brake::COAST;
+  double ratio = gears == gearSetting::ratio36_1 ? 36 : gears == gearSetting::ratio6_1 ? 6 : 18;
+  simMotor(index).setCartridge(ratio);
+}
+
+int32_t motor::index() { return this->port; }
+bool motor::installed() { return true; }
+
+void motor::setReversed(bool value) { this->reversed = value; }
+
+void motor::setVelocity(double velocity, percentUnits units) {
+  settings(this->port).velocity = velocity;
+}
+
+void motor::setVelocity(double velocity, velocityUnits units) {
+  sim::Motor& motor = simMotor(this->port);
+  double maxRpm = motor.maxSpeed() * 60 / (2 * M_PI);
+  switch(units) {
+    case velocityUnits::rpm: settings(this->port).velocity = velocity / maxRpm * 100;
+                             break;
+    case velocityUnits::dps: settings(this->port).velocity = velocity / 6 / maxRpm * 100;
+                             break;
+    default:                 settings(this->port).velocity = velocity;
+                             break;
+  }
+}
+
+void motor::setBrake(brakeType mode) { settings(this->port).stopping = toBrake(mode); }
+void motor::setStopping(brakeType mode) { settings(this->port).stopping = toBrake(mode); }
+void motor::setMaxTorque(double value, percentUnits units) {}
+void motor::setTimeout(int32_t time, timeUnits units) {}
+
+void motor::resetRotation() { simMotor(this->port).resetEncoder(); }
+void motor::resetPosition() { simMotor(this->port).resetEncoder(); }
+void motor::setRotation(double value, rotationUnits units) { this->setPosition(value, units); }
+
+// Only zeroing is supported; anything else is treated as zero.
+void motor::setPosition(double value, rotationUnits units) { simMotor(this->port).resetEncoder(); }
+
+void motor::spin(directionType dir) {
+  sim::Motor& motor = simMotor(this->port);
+  double sign = (dir == directionType::rev) != this->reversed ? -1 : 1;
+  motor.commandVelocity(sign * percentToSpeed(motor, settings(this->port).velocity));
+}
+
+void motor::spin(directionType dir, double velocity, velocityUnits units) {
+  this->setVelocity(velocity, units);
+  this->spin(dir);
+}
+
+void motor::spin(directionType dir, double velocity, percentUnits units) {
+  this->setVelocity(velocity, units);
+  this->spin(dir);
+}
+
+void motor::spin(directionType dir, double voltage, voltageUnits units) {
+  double sign = (dir == directionType::rev) != this->reversed ? -1 : 1;
+  double volts = units == voltageUnits::mV ? voltage / 1000 : voltage;
+  simMotor(this->port).commandVoltage(sign * volts);
+}
+
+bool motor::startRotateTo(double rotation, rotationUnits units) {
+  sim::Motor& motor = simMotor(this->port);
+  double sign = this->reversed ? -1 : 1;
+  motor.commandPosition(sign * toRadians(motor, rotation, units),
+                        percentToSpeed(motor, settings(this->port).velocity));
+  return motor.isDone();
+}
+
+bool motor::startRotateTo(double rotation, rotationUnits units, double velocity, velocityUnits units_v) {
+  this->setVelocity(velocity, units_v);
+  return this->startRotateTo(rotation, units);
+}
+
+bool motor::startRotateFor(double rotation, rotationUnits units) {
+  return this->startRotateTo(this->position(units) + rotation, units);
+}
+
+// Blocking moves run the simulation until the move is done, or for ten seconds at most.
+bool motor::rotateTo(double rotation, rotationUnits units, bool waitForCompletion) {
+  this->startRotateTo(rotation, units);
+  for(int i = 0; waitForCompletion && i < 1000 && !this->isDone(); i++) {
+    sim::World::current().advance(10);
+  }
+  return this->isDone();
+}
+
+bool motor::rotateFor(double rotation, rotationUnits units, bool waitForCompletion) {
+  return this->rotateTo(this->position(units) + rotation, units, waitForCompletion);
+}
+
+void motor::stop() { simMotor(this->port).commandStop(settings(this->port).stopping); }
+void motor::stop(brakeType mode) { simMotor(this->port).commandStop(toBrake(mode)); }
+
+bool motor::isSpinning() { return fabs(simMotor(this->port).getSpeed()) > 0.05; }
+bool motor::isDone() { return simMotor(this->port).isDone(); }
+
+double motor::rotation(rotationUnits units) { return this->position(units); }
+
+double motor::position(rotationUnits units) {
+  sim::Motor& motor = simMotor(this->port);
+  return (this->reversed ? -1 : 1) * fromRadians(motor, motor.getAngle(), units);
+}
+
+double motor::velocity(velocityUnits units) {
+  sim::Motor& motor = simMotor(this->port);
+  double speed = (this->reversed ? -1 : 1) * motor.getReportedSpeed();
+  switch(units) {
+    case velocityUnits::rpm: return speed * 60 / (2 * M_PI);
+    case velocityUnits::dps: return speed * 180 / M_PI;
+    default:                 return speed / motor.maxSpeed() * 100;
+  }
+}
+
+double motor::velocity(percentUnits units) { return this->velocity(velocityUnits::pct); }
+
+double motor::current(currentUnits units) { return simMotor(this->port).getCurrent(); }
+double motor::current(percentUnits units) { return simMotor(this->port).getCurrent() / 2.5 * 100; }
+
+double motor::voltage(voltageUnits units) {
+  double volts = (this->reversed ? -1 : 1) * simMotor(this->port).getVoltage();
+  return units == voltageUnits::mV ? volts * 1000 : volts;
+}
+
+double motor::power(powerUnits units) {
+  sim::Motor& motor = simMotor(this->port);
+  return fabs(motor.getVoltage() * motor.getCurrent());
+}
+
+double motor::torque(torqueUnits units) {
+  double torque = fabs(simMotor(this->port).getTorque());
+  return units == torqueUnits::InLb ? torque * 8.8507 : torque;
+}
+
+double motor::efficiency(percentUnits units) {
+  sim::Motor& motor = simMotor(this->port);
+  double in = fabs(motor.getVoltage() * motor.getCurrent());
+  return in > 0 ? fabs(motor.getTorque() * motor.getSpeed()) / in * 100 : 0;
+}
+
+// The V5 reports temperature as a percentage between 20C and 70C.
+double motor::temperature(percentUnits units) {
+  return (simMotor(this->port).getTemperature() - 20) * 2;
+}
+
+double motor::temperature(temperatureUnits units) {
+  double celsius = simMotor(this->port).getTemperature();
+  return units == temperatureUnits::fahrenheit ? celsius * 9 / 5 + 32 : celsius;
+}
+
+/*
+ * timer
+ */
+timer::timer() { this->clear(); }
+double timer::time() { return this->time(timeUnits::msec); }
+
+double timer::time(timeUnits units) {
+  double ms = (sim::World::current().micros() - this->start) / 1000.0;
+  return units == timeUnits::sec ? ms / 1000 : ms;
+}
+
+double timer::value() { return this->time(timeUnits::sec); }
+void timer::clear() { this->start = sim::World::current().micros(); }
+uint32_t timer::system() { return (uint32_t) (sim::World::current().micros() / 1000); }
+uint64_t timer::systemHighResolution() { return sim::World::current().micros(); }
+
+/*
+ * task
+ */
+task::task() { this->taskPriority = taskPriorityNormal; }
+task::task(int (*callback)(void)) { this->taskPriority = taskPriorityNormal; }
+task::task(int (*callback)(void), int32_t priority) { this->taskPriority = priority; }
+task::task(int (*callback)(void*), void* arg) { this->taskPriority = taskPriorityNormal; }
+task::task(int (*callback)(void*), void* arg, int32_t priority) { this->taskPriority = priority; }
+
+void task::stop() {}
+void task::suspend() {}
+void task::resume() {}
+int32_t task::priority() { return this->taskPriority; }
+void task::setPriority(int32_t priority) { this->taskPriority = priority; }
+
+void task::sleep(uint32_t time) { sim::World::current().advance(time); }
+void task::yield() {}
+
+void this_thread::sleep_for(uint32_t time) { sim::World::current().advance(time); }
+void this_thread::yield() {}
+
+void wait(double time, timeUnits units) {
+  sim::World::current().advance((uint32_t) (units == timeUnits::sec ? time * 1000 : time));
+}
+
+/*
+ * mutex
+ */
+void mutex::lock() { this->handle.lock(); }
+bool mutex::try_lock() { return this->handle.try_lock(); }
+void mutex::unlock() { this->handle.unlock(); }
+
+/*
+ * controller
+ */
+controller::controller() : controller(controllerType::primary) {}
+
+controller::controller(controllerType id) :
+  Axis1(id == controllerType::partner, 0),
+  Axis2(id == controllerType::partner, 1),
+  Axis3(id == controllerType::partner, 2),
+  Axis4(id == controllerType::partner, 3),
+  ButtonL1(id == controllerType::partner, sim::L1),
+  ButtonL2(id == controllerType::partner, sim::L2),
+  ButtonR1(id == controllerType::partner, sim::R1),
+  ButtonR2(id == controllerType::partner, sim::R2),
+  ButtonUp(id == controllerType::partner, sim::UP),
+  ButtonDown(id == controllerType::partner, sim::DOWN),
+  ButtonLeft(id == controllerType::partner, sim::LEFT),
+  ButtonRight(id == controllerType::partner, sim::RIGHT),
+  ButtonX(id == controllerType::partner, sim::X),
+  ButtonB(id == controllerType::partner, sim::B),
+  ButtonY(id == controllerType::partner, sim::Y),
+  ButtonA(id == controllerType::partner, sim::A) {
+  this->id = id == controllerType::partner;
+}
+
+controller::axis::axis(int32_t controllerId, int32_t index) {
+  this->controllerId = controllerId;
+  this->index = index;
+}
+
+int32_t controller::axis::value() { return this->position(); }
+int32_t controller::axis::position(percentUnits units) { return this->position(); }
+
+int32_t controller::axis::position() {
+  return sim::World::current().controllers[this->controllerId].axis[this->index];
+}
+
+controller::button::button(int32_t controllerId, int32_t index) {
+  this->controllerId = controllerId;
+  this->index = index;
+}
+
+bool controller::button::pressing() {
+  return sim::World::current().controllers[this->controllerId].button[this->index];
+}
+
+void controller::lcd::setCursor(int32_t row, int32_t col) {}
+void controller::lcd::print(const char* format, ...) {}
+void controller::lcd::clearScreen() {}
+void controller::lcd::clearLine() {}
+void controller::lcd::clearLine(int32_t number) {}
+void controller::lcd::newLine() {}
+
+void controller::rumble(const char* pattern) {}
+bool controller::installed() { return true; }
+
+/*
+ * competition
+ */
+void competition::autonomous(void (*callback)(void)) {}
+void competition::drivercontrol(void (*callback)(void)) {}
+bool competition::isEnabled() { return true; }
+bool competition::isDriverControl() { return true; }
+bool competition::isAutonomous() { return false; }
+bool competition::isCompetitionSwitch() { return false; }
+bool competition::isFieldControl() { return false; }
+
+/*
+ * brain
+ */
+double brain::battery::voltage(voltageUnits units) {
+  double volts = sim::World::current().battery.voltage();
+  return units == voltageUnits::mV ? volts * 1000 : volts;
+}
+
+double brain::battery::current(currentUnits units) {
+  sim::World& world = sim::World::current();
+  double total = world.battery.idleCurrent;
+  for(int i = 0; i < _SIM_WORLD_PORTS; i++) total += world.motor(i).getSupplyCurrent();
+  return total;
+}
+
+uint32_t brain::battery::capacity(percentUnits units) {
+  return (uint32_t) (sim::World::current().battery.charge() * 100);
+}
+
+/*
+ * color
+ */
+color::color() { this->value = 0; }
+color::color(uint32_t value) { this->value = value; }
+uint32_t color::rgb() const { return this->value; }
+
+const color color::black  = color(0x000000);
+const color color::white  = color(0xFFFFFF);
+const color color::red    = color(0xFF0000);
+const color color::green  = color(0x00FF00);
+const color color::blue   = color(0x0000FF);
+const color color::yellow = color(0xFFFF00);
+const color color::orange = color(0xFFA500);
+
+/*
+ * brain::lcd, which only counts what it would have drawn
+ */
+
+// Screen size, and the size of one character of the default font.
+#define SCREEN_WIDTH  480
+#define SCREEN_HEIGHT 272
+#define FONT_WIDTH    10
+#define FONT_HEIGHT   20
+
+static void countDraw(uint64_t pixels) {
+  sim::Screen& screen = sim::World::current().screen;
+  screen.calls++;
+  screen.pixels += pixels;
+}
+
+void brain::lcd::setPenColor(const color& value) {}
+void brain::lcd::setFillColor(const color& value) {}
+void brain::lcd::clearScreen() { countDraw(SCREEN_WIDTH * SCREEN_HEIGHT); }
+void brain::lcd::clearScreen(const color& value) { countDraw(SCREEN_WIDTH * SCREEN_HEIGHT); }
+void brain::lcd::render() {}
+
+void brain::lcd::drawRectangle(int32_t x, int32_t y, int32_t width, int32_t height) {
+  countDraw((uint64_t) abs(width) * abs(height));
+}
+
+void brain::lcd::drawLine(int32_t x1, int32_t y1, int32_t x2, int32_t y2) {
+  countDraw(std::max(abs(x2 - x1), abs(y2 - y1)) + 1);
+}
+
+void brain::lcd::printAt(int32_t x, int32_t y, const char* format, ...) {
+  char text[128];
+  va_list args;
+  va_start(args, format);
+  int length = vsnprintf(text, sizeof(text), format, args);
+  va_end(args);
+  countDraw((uint64_t) std::max(length, 0) * FONT_WIDTH * FONT_HEIGHT);
+}
+
+/*
+ * brain::sdcard, backed by the directory in `sim::World::sdcard`
+ */
+
+// Open `name` on the simulated card, or return nullptr if there is no card.
+static FILE* openCardFile(const char* name, const char* mode) {
+  const char* root = sim::World::current().sdcard;
+  if(root == nullptr) return nullptr;
+  char path[512];
+  snprintf(path, sizeof(path), "%s/%s", root, name);
+  return fopen(path, mode);
+}
+
+bool brain::sdcard::isInserted() {
+  return sim::World::current().sdcard != nullptr;
+}
+
+bool brain::sdcard::exists(const char* name) {
+  FILE* file = openCardFile(name, "rb");
+  if(file != nullptr) fclose(file);
+  return file != nullptr;
+}
+
+int32_t brain::sdcard::size(const char* name) {
+  FILE* file = openCardFile(name, "rb");
+  if(file == nullptr) return 0;
+  fseek(file, 0, SEEK_END);
+  int32_t size = (int32_t) ftell(file);
+  fclose(file);
+  return size;
+}
+
+int32_t brain::sdcard::loadfile(const char* name, uint8_t* buffer, int32_t len) {
+  FILE* file = openCardFile(name, "rb");
+  if(file == nullptr) return 0;
+  int32_t read = (int32_t) fread(buffer, 1, len, file);
+  fclose(file);
+  return read;
+}
+
+int32_t brain::sdcard::savefile(const char* name, uint8_t* buffer, int32_t len) {
+  FILE* file = openCardFile(name, "wb");
+  if(file == nullptr) return 0;
+  int32_t written = (int32_t) fwrite(buffer, 1, len, file);
+  fclose(file);
+  return written;
+}
+
+int32_t brain::sdcard::appendfile(const char* name, uint8_t* buffer, int32_t len) {
+  FILE* file = openCardFile(name, "ab");
+  if(file == nullptr) return 0;
+  int32_t written = (int32_t) fwrite(buffer, 1, len, file);
+  fclose(file);
+  return written;
+}
+
+}
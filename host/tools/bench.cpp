@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Benchmark and regression check for the `update()` of every subsystem.
+ *
+ * Each subsystem is driven through the same synthetic controller trace (sticks
+ * wandering, jumping and sitting inside the deadband, buttons being pressed and
+ * released) against the simulated motors, and measured for:
+ *  - ns/tick: wall-clock time spent in one `update()`, best of several passes;
+ *  - commands/tick: commands that reached the motors per `update()`, which is
+ *    deterministic.
+ *
+ * Every pass of a subsystem is paired with a pass of a fixed reference workload, and
+ * the time is also kept as a ratio to that, which takes out most of the difference
+ * between machines and between a busy and an idle one.
+ *
+ * The results are compared against a stored baseline.  The run fails (exit status 1)
+ * if the time ratio is more than the tolerance over its baseline, or commands/tick is
+ * over its baseline at all.  Regenerate the baseline with -u after a change that is
+ * meant to make things slower or issue more commands.
+ *
+ * Usage:
+ *    build/bench [-b file] [-t percent] [-u]
+ *
+ *    -b    baseline file, default bench.txt
+ *    -t    allowed slowdown in the time ratio, in percent, default 30
+ *    -u    write the results as the new baseline instead of checking them
+ */
+
+#include "vex.h"
+#include "sim/World.h"
+#include "Motors.h"
+#include "subsystems/MecanumDriveArcade.h"
+#include "subsystems/MecanumDriveTank.h"
+#include "subsystems/RD4BLift.h"
+#include "subsystems/RollerIntake.h"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Same tick length as on the robot; 4000 ticks is 100 seconds.
+#define TICK 25
+#define TICKS 4000
+#define PASSES 7
+
+// `update()` calls per tick.  Timing several back to back keeps the cost of reading the
+// clock small next to what is being measured.
+#define REPEATS 8
+
+#define AxisInput(x)   ([&]() -> int32_t {return joystick.x.position();})
+#define ButtonInput(y) ([&]() -> bool    {return joystick.y.pressing();})
+
+struct Measurement {
+  const char* name;
+  double nanos;       // per tick
+  double ratio;       // to the reference workload
+  double commands;    // per tick
+};
+
+/*
+ * Stands in for a subsystem that always does the same amount of work, about as much
+ * as a drive update.
+ */
+class Reference : public Subsystem {
+  public:
+    void update() override {
+      for(int i = 0; i < 64; i++) this->state = this->state * 1664525u + 1013904223u;
+    }
+    volatile uint32_t state = 1;
+};
+
+/*
+ * Moves the controller for one tick.  Every axis mostly wanders, now and then jumps to
+ * a new position or comes back to rest inside the deadband, and each button is
+ * pressed or released every couple of seconds.
+ */
+static void applyTrace(sim::Controller& input, std::mt19937& random) {
+  std::uniform_int_distribution<int32_t> percent(0, 99);
+  for(int32_t& axis : input.axis) {
+    int32_t roll = percent(random);
+    if(roll < 3) axis = percent(random) * 2 - 99;
+    else if(roll < 5) axis = percent(random) % 7 - 3;
+    else axis = std::max(-100, std::min(100, axis + percent(random) % 11 - 5));
+  }
+  for(bool& button : input.button) {
+    if(percent(random) < 2) button = !button;
+  }
+}
+
+/*
+ * One pass: `TICKS` ticks of `subsystem`, built by `make` in a fresh world.  Returns the
+ * time spent in `update()` and the number of motor commands, totalled.
+ */
+template<typename Make>
+static void pass(Make make, double& nanos, uint64_t& commands) {
+  sim::World world;
+  world.makeCurrent();
+  controller joystick = controller(primary);
+  std::mt19937 random(1);
+  auto subsystem = make(joystick);
+  subsystem->prepare();
+
+  uint32_t before = 0;
+  for(int i = 0; i < _SIM_WORLD_PORTS; i++) before += world.motor(i).commands;
+
+  nanos = 0;
+  for(uint32_t t = 0; t < TICKS; t++) {
+    applyTrace(world.controllers[0], random);
+    auto started = std::chrono::steady_clock::now();
+    for(int i = 0; i < REPEATS; i++) subsystem->update();
+    nanos += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started).count();
+    world.advance(TICK);
+  }
+
+  commands = 0;
+  for(int i = 0; i < _SIM_WORLD_PORTS; i++) commands += world.motor(i).commands;
+  commands -= before;
+  nanos /= REPEATS;
+  commands /= REPEATS;
+}
+
+template<typename Make>
+static Measurement measure(const char* name, Make make) {
+  auto makeReference = [](controller& joystick) { return std::unique_ptr<Reference>(new Reference()); };
+  Measurement result = { name, 0, 0, 0 };
+  double fastestReference = 0;
+  // The first pass only warms up the caches and the CPU clock, and isn't counted.
+  for(int i = -1; i < PASSES; i++) {
+    double nanos, reference;
+    uint64_t commands;
+    pass(makeReference, reference, commands);
+    pass(make, nanos, commands);
+    if(i < 0) continue;
+    if(i == 0 || nanos / TICKS < result.nanos) result.nanos = nanos / TICKS;
+    if(i == 0 || reference / TICKS < fastestReference) fastestReference = reference / TICKS;
+    result.commands = (double) commands / TICKS;
+  }
+  result.ratio = result.nanos / fastestReference;
+  return result;
+}
+
+int main(int argc, char** argv) {
+  const char* baselinePath = "bench.txt";
+  double tolerance = 30;
+  bool update = false;
+  for(int i = 1; i < argc; i++) {
+    if(strcmp(argv[i], "-u") == 0) update = true;
+    else if(strcmp(argv[i], "-b") == 0 && i + 1 < argc) baselinePath = argv[++i];
+    else if(strcmp(argv[i], "-t") == 0 && i + 1 < argc) tolerance = atof(argv[++i]);
+    else {
+      fprintf(stderr, "usage: bench [-b file] [-t percent] [-u]\n");
+      return 1;
+    }
+  }
+
+  auto started = std::chrono::steady_clock::now();
+
+  /*
+   * MecanumDriveTank is set up the way main.cpp sets it up: strafe on A and Y, the
+   * feedforward model, traction control and the lift-height limits (read straight off
+   * the lift motor, as RD4BLift::getHeight() does).  The lift also gets the preset
+   * buttons, which main.cpp leaves off, so that every state is timed.  The arcade drive
+   * isn't on the robot, and is timed plain.
+   */
+  Measurement results[] = {
+    measure("MecanumDriveArcade", [](controller& joystick) {
+      return std::unique_ptr<MecanumDriveArcade>(new MecanumDriveArcade(
+        AxisInput(Axis3), AxisInput(Axis4), AxisInput(Axis1),
+        FRONT_RIGHT_MOTOR_PORT, FRONT_LEFT_MOTOR_PORT, BACK_RIGHT_MOTOR_PORT, BACK_LEFT_MOTOR_PORT));
+    }),
+    measure("MecanumDriveTank", [](controller& joystick) {
+      auto strafe = [&]() -> int32_t {
+        if(joystick.ButtonA.pressing() == joystick.ButtonY.pressing()) return 0;
+        return joystick.ButtonA.pressing() ? 75 : -75;
+      };
+      std::unique_ptr<MecanumDriveTank> drive(new MecanumDriveTank(
+        AxisInput(Axis3), AxisInput(Axis2), strafe, ButtonInput(ButtonB),
+        FRONT_RIGHT_MOTOR_PORT, FRONT_LEFT_MOTOR_PORT, BACK_RIGHT_MOTOR_PORT, BACK_LEFT_MOTOR_PORT));
+      drive->setLiftHeight([]() -> double {
+        return Motors::get(LIFT_LEFT_MOTOR_PORT).position(rotationUnits::rev);
+      });
+      drive->useFeedforward(true);
+      drive->useTractionControl(false);
+      return drive;
+    }),
+    measure("RD4BLift", [](controller& joystick) {
+      return std::unique_ptr<RD4BLift>(new RD4BLift(
+        AxisInput(Axis2), ButtonInput(ButtonRight), ButtonInput(ButtonDown), ButtonInput(ButtonUp),
+        LIFT_LEFT_MOTOR_PORT, LIFT_RIGHT_MOTOR_PORT));
+    }),
+    measure("RollerIntake", [](controller& joystick) {
+      return std::unique_ptr<RollerIntake>(new RollerIntake(
+        ButtonInput(ButtonR1), ButtonInput(ButtonR2), ROLLER_LEFT_MOTOR_PORT, ROLLER_RIGHT_MOTOR_PORT));
+    }),
+  };
+
+  double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+  if(update) {
+    FILE* file = fopen(baselinePath, "w");
+    if(file == nullptr) {
+      fprintf(stderr, "couldn't write %s\n", baselinePath);
+      return 1;
+    }
+    fprintf(file, "# subsystem ns/tick time-ratio commands/tick, written by build/bench -u\n");
+    for(const Measurement& result : results) {
+      fprintf(file, "%s %.1f %.3f %.3f\n", result.name, result.nanos, result.ratio, result.commands);
+    }
+    fclose(file);
+    printf("wrote %s\n", baselinePath);
+  }
+
+  // Read the baseline back; anything missing from it is reported but can't fail.
+  Measurement baseline[sizeof(results) / sizeof(results[0])];
+  bool found[sizeof(results) / sizeof(results[0])] = {};
+  FILE* file = fopen(baselinePath, "r");
+  char line[128];
+  while(file != nullptr && fgets(line, sizeof(line), file) != nullptr) {
+    char name[64];
+    double nanos, ratio, commands;
+    if(line[0] == '#' || sscanf(line, "%63s %lf %lf %lf", name, &nanos, &ratio, &commands) != 4) continue;
+    for(size_t i = 0; i < sizeof(results) / sizeof(results[0]); i++) {
+      if(strcmp(name, results[i].name) == 0) {
+        baseline[i] = { results[i].name, nanos, ratio, commands };
+        found[i] = true;
+      }
+    }
+  }
+  if(file != nullptr) fclose(file);
+
+  bool failed = false;
+  printf("%-20s %8s %8s %8s %8s %14s %8s\n",
+         "subsystem", "ns/tick", "baseline", "ratio", "baseline", "commands/tick", "baseline");
+  for(size_t i = 0; i < sizeof(results) / sizeof(results[0]); i++) {
+    const Measurement& result = results[i];
+    const char* status = "ok";
+    if(!found[i]) {
+      status = "no baseline";
+    } else if(result.commands > baseline[i].commands + 0.0005) {
+      status = "FAIL commands";
+      failed = true;
+    } else if(result.ratio > baseline[i].ratio * (1 + tolerance / 100)) {
+      status = "FAIL time";
+      failed = true;
+    }
+    printf("%-20s %8.1f %8.1f %8.3f %8.3f %14.3f %8.3f  %s\n", result.name,
+           result.nanos, found[i] ? baseline[i].nanos : 0, result.ratio, found[i] ? baseline[i].ratio : 0,
+           result.commands, found[i] ? baseline[i].commands : 0, status);
+  }
+  printf("\n%d ticks x %d passes per subsystem in %.2fs\n", TICKS, PASSES, elapsed);
+
+  return failed ? 1 : 0;
+}
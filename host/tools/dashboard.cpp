@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Measures what the Brain screen dashboard costs per frame.  Runs the autonomous
+ * routine and then a minute of the lift cycling between presets, drawing a frame
+ * every _DASHBOARD_H_FRAME_TIME, and reports per frame how many widgets were redrawn,
+ * how many drawing calls and pixels that came to on the stand-in screen, and how long
+ * `Dashboard::draw()` itself took on this machine.
+ *
+ * Usage:
+ *    build/dashboard           summary only
+ *    build/dashboard -t        also print a CSV trace, one row per frame
+ */
+
+#include "vex.h"
+#include "sim/World.h"
+#include "subsystems/MecanumDriveTank.h"
+#include "subsystems/RD4BLift.h"
+#include "subsystems/RollerIntake.h"
+#include "commands/Scheduler.h"
+#include "Autonomous.h"
+#include "Dashboard.h"
+#include "Sensing.h"
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+
+// Same tick length as on the robot.
+#define TICK 25
+#define AUTON_LENGTH 15000
+#define DRIVER_LENGTH 60000
+
+#define AxisInput(x)   ([&]() -> int32_t {return joystick.x.position();})
+#define ButtonInput(y) ([&]() -> bool    {return joystick.y.pressing();})
+
+int main(int argc, char** argv) {
+  bool trace = argc > 1 && strcmp(argv[1], "-t") == 0;
+
+  sim::World world;
+  world.makeCurrent();
+  controller joystick = controller(primary);
+  sim::Controller& input = world.controllers[0];
+
+  RD4BLift lift([]() -> int32_t { return 0; },
+                ButtonInput(ButtonRight), ButtonInput(ButtonDown), ButtonInput(ButtonUp),
+                LIFT_LEFT_MOTOR_PORT, LIFT_RIGHT_MOTOR_PORT);
+  RollerIntake intake(ButtonInput(ButtonR1), ButtonInput(ButtonR2),
+                      ROLLER_LEFT_MOTOR_PORT, ROLLER_RIGHT_MOTOR_PORT);
+  MecanumDriveTank drive(AxisInput(Axis3), AxisInput(Axis2), AxisInput(Axis4), ButtonInput(ButtonB),
+                         FRONT_RIGHT_MOTOR_PORT, FRONT_LEFT_MOTOR_PORT,
+                         BACK_RIGHT_MOTOR_PORT, BACK_LEFT_MOTOR_PORT);
+  Subsystem* subsystems[3] = { &lift, &intake, &drive };
+  for(Subsystem* subsystem : subsystems) subsystem->prepare();
+  Scheduler scheduler(subsystems, 3);
+  Sensing sensing;
+  Dashboard dashboard;
+
+  Command* routine = buildAutonomous(&drive, &lift, &intake);
+  scheduler.schedule(routine);
+
+  // Lift presets pressed in turn during driver control, with the drive going back and forth.
+  const sim::Button presets[] = { sim::UP, sim::DOWN, sim::RIGHT };
+
+  uint32_t frames = 0, totalWidgets = 0, worstWidgets = 0, worstCalls = 0;
+  uint64_t totalPixels = 0, worstPixels = 0, firstPixels = 0;
+  double totalNanos = 0, worstNanos = 0;
+
+  if(trace) printf("ms,widgets,calls,pixels,ns\n");
+  for(uint32_t t = 0; t < AUTON_LENGTH + DRIVER_LENGTH; t += TICK) {
+    if(t == AUTON_LENGTH) scheduler.cancelAll();
+    if(t >= AUTON_LENGTH) {
+      uint32_t driver = t - AUTON_LENGTH;
+      for(sim::Button preset : presets) input.button[preset] = false;
+      if(driver % 4000 == 0) input.button[presets[driver / 4000 % 3]] = true;
+      input.axis[2] = input.axis[1] = driver % 8000 < 4000 ? 60 : -60;
+    }
+
+    // Publish what the control and sensing tasks would, with a made-up loop time.
+    scheduler.update();
+    ControlState state = {};
+    state.time = timer::system();
+    state.liftState = lift.getState();
+    state.liftHeight = lift.getHeight();
+    state.busy = 400;
+    state.period = TICK * 1000;
+    state.watchdogLevel = Watchdog::Level::NORMAL;
+    controlState.write(state);
+    sensing.update();
+    world.advance(TICK);
+
+    if(t % _DASHBOARD_H_FRAME_TIME != 0) continue;
+
+    world.screen.calls = 0;
+    world.screen.pixels = 0;
+    auto started = std::chrono::steady_clock::now();
+    uint32_t widgets = dashboard.draw();
+    double nanos = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started).count();
+
+    if(frames == 0) firstPixels = world.screen.pixels;
+    else {
+      // The first frame clears the screen and draws everything, so keep it separate.
+      totalWidgets += widgets;
+      totalPixels += world.screen.pixels;
+      totalNanos += nanos;
+      worstWidgets = std::max(worstWidgets, widgets);
+      worstCalls = std::max(worstCalls, world.screen.calls);
+      worstPixels = std::max(worstPixels, world.screen.pixels);
+      worstNanos = std::max(worstNanos, nanos);
+    }
+    frames++;
+    if(trace) printf("%u,%u,%u,%llu,%.0f\n", t, widgets, world.screen.calls,
+                     (unsigned long long) world.screen.pixels, nanos);
+  }
+
+  uint32_t counted = frames - 1;
+  fprintf(trace ? stderr : stdout,
+          "%u frames over %.0fs, first (full) frame %llu pixels\n"
+          "widgets redrawn per frame: %.2f average, %u worst\n"
+          "pixels drawn per frame:    %.0f average, %llu worst, %u calls worst\n"
+          "draw() time per frame:     %.0fns average, %.0fns worst\n",
+          frames, (AUTON_LENGTH + DRIVER_LENGTH) / 1000.0, (unsigned long long) firstPixels,
+          (double) totalWidgets / counted, worstWidgets,
+          (double) totalPixels / counted, (unsigned long long) worstPixels, worstCalls,
+          totalNanos / counted, worstNanos);
+  return 0;
+}
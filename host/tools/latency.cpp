@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Measures stick-to-motor latency on the simulated robot with the same probe the
+ * robot uses (see LatencyProbe.h).  The left drive stick is stepped between rest and
+ * full travel at random moments, so that the steps land at every point of the tick,
+ * and the distribution of each stage is printed at the end.
+ *
+ * Simulated time stands still while robot code runs, so the tick itself always shows
+ * up as 0ms here; the other two stages are what the loop period and the motors cost.
+ *
+ * Usage:
+ *    build/latency [-n samples] [-p period] [-s seed]
+ *
+ *    -n    samples to collect, default 200
+ *    -p    control loop period in milliseconds, default 25 as in teleop()
+ *    -s    random seed
+ */
+
+#include "vex.h"
+#include "sim/World.h"
+#include "subsystems/MecanumDriveTank.h"
+#include "commands/Scheduler.h"
+#include "LatencyProbe.h"
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define AxisInput(x)   ([&]() -> int32_t {return joystick.x.position();})
+#define ButtonInput(y) ([&]() -> bool    {return joystick.y.pressing();})
+
+int main(int argc, char** argv) {
+  uint32_t wanted = 200, period = 25, seed = 1;
+  for(int i = 1; i + 1 < argc; i += 2) {
+    if(strcmp(argv[i], "-n") == 0) wanted = atoi(argv[i + 1]);
+    else if(strcmp(argv[i], "-p") == 0) period = atoi(argv[i + 1]);
+    else if(strcmp(argv[i], "-s") == 0) seed = atoi(argv[i + 1]);
+  }
+  if(wanted > _LATENCYPROBE_H_SAMPLES) {
+    printf("only the last %d samples are kept\n", _LATENCYPROBE_H_SAMPLES);
+  }
+
+  sim::World world;
+  world.makeCurrent();
+  controller joystick = controller(primary);
+  sim::Controller& input = world.controllers[0];
+
+  MecanumDriveTank drive(AxisInput(Axis3), AxisInput(Axis2), AxisInput(Axis4), ButtonInput(ButtonB),
+                         FRONT_RIGHT_MOTOR_PORT, FRONT_LEFT_MOTOR_PORT,
+                         BACK_RIGHT_MOTOR_PORT, BACK_LEFT_MOTOR_PORT);
+  drive.prepare();
+  Subsystem* subsystems[1] = { &drive };
+  Scheduler scheduler(subsystems, 1);
+  LatencyProbe probe(AxisInput(Axis3), FRONT_LEFT_MOTOR_PORT);
+
+  std::mt19937 random(seed);
+  std::uniform_int_distribution<uint32_t> hold(400, 800);
+  uint32_t nextStep = hold(random), nextTick = 0;
+
+  // Step every millisecond: move the stick when it's time, poll the probe the way its
+  // task would, and run a tick of the control loop every `period`.
+  for(uint32_t t = 0; probe.getSampleCount() < wanted; t++) {
+    if(t == nextStep) {
+      input.axis[2] = input.axis[2] == 0 ? (random() % 2 ? 100 : -100) : 0;
+      nextStep = t + hold(random);
+    }
+
+    probe.poll();
+
+    if(t == nextTick) {
+      probe.tickStarted(timer::systemHighResolution());
+      scheduler.update();
+      probe.tickEnded(timer::systemHighResolution());
+      nextTick = t + period;
+    }
+
+    world.advance(1);
+  }
+
+  probe.report();
+  return 0;
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Runs the autonomous routine against the simulated robot and reports where it ended
+ * up and how long it took, both in match time and in wall-clock time.
+ *
+ * Usage:
+ *    build/simulate            summary only
+ *    build/simulate -t         also print a CSV trace, one row per tick
+ *    build/simulate -c 0.2     start with the battery at 20% charge
+ */
+
+#include "vex.h"
+#include "sim/World.h"
+#include "subsystems/MecanumDriveTank.h"
+#include "subsystems/RD4BLift.h"
+#include "subsystems/RollerIntake.h"
+#include "commands/Scheduler.h"
+#include "Autonomous.h"
+#include "Sensing.h"
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Same tick and period length as on the robot.
+#define TICK 25
+#define AUTON_LENGTH 15000
+
+#define AxisInput(x)   ([&]() -> int32_t {return joystick.x.position();})
+#define ButtonInput(y) ([&]() -> bool    {return joystick.y.pressing();})
+
+int main(int argc, char** argv) {
+  bool trace = false;
+  double charge = 1;
+  for(int i = 1; i < argc; i++) {
+    if(strcmp(argv[i], "-t") == 0) trace = true;
+    else if(strcmp(argv[i], "-c") == 0 && i + 1 < argc) charge = atof(argv[++i]);
+  }
+
+  sim::World world;
+  world.makeCurrent();
+  world.battery.setCharge(charge);
+  controller joystick = controller(primary);
+
+  // Built the same way as in main.cpp, with nobody touching the controller.
+  RD4BLift lift([]() -> int32_t { return 0; }, LIFT_LEFT_MOTOR_PORT, LIFT_RIGHT_MOTOR_PORT);
+  RollerIntake intake(ButtonInput(ButtonR1), ButtonInput(ButtonR2),
+                      ROLLER_LEFT_MOTOR_PORT, ROLLER_RIGHT_MOTOR_PORT);
+  MecanumDriveTank drive(AxisInput(Axis3), AxisInput(Axis2), AxisInput(Axis4), ButtonInput(ButtonB),
+                         FRONT_RIGHT_MOTOR_PORT, FRONT_LEFT_MOTOR_PORT,
+                         BACK_RIGHT_MOTOR_PORT, BACK_LEFT_MOTOR_PORT);
+  drive.setLiftHeight([&]() -> double { return lift.getHeight(); });
+  drive.useFeedforward(true);
+  drive.useTractionControl(false);
+  Subsystem* subsystems[3] = { &lift, &intake, &drive };
+  for(Subsystem* subsystem : subsystems) subsystem->prepare();
+  Scheduler scheduler(subsystems, 3);
+
+  // Tasks don't run on the host, so sample the battery (and with it the voltage
+  // compensation) once a tick instead.
+  Sensing sensing;
+
+  auto started = std::chrono::steady_clock::now();
+
+  Command* routine = buildAutonomous(&drive, &lift, &intake);
+  scheduler.schedule(routine);
+  uint32_t finished = 0;
+  if(trace) printf("ms,x,y,heading,forward,lift,battery,slip_fl,slip_fr,slip_bl,slip_br\n");
+  for(uint32_t t = 0; t < AUTON_LENGTH; t += TICK) {
+    if(scheduler.isScheduled(routine)) finished = t + TICK;
+    sensing.update();
+    scheduler.update();
+    world.advance(TICK);
+    if(trace) {
+      printf("%u,%.3f,%.3f,%.3f,%.3f,%.3f,%.2f,%.3f,%.3f,%.3f,%.3f\n",
+             t + TICK, world.chassis.x, world.chassis.y, world.chassis.heading,
+             world.chassis.forwardSpeed, world.lift.height(), world.battery.voltage(),
+             world.chassis.slip[0], world.chassis.slip[1], world.chassis.slip[2], world.chassis.slip[3]);
+    }
+  }
+
+  double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+
+  fprintf(trace ? stderr : stdout,
+          "routine %s after %.2fs\n"
+          "final pose: x %.3fm y %.3fm heading %.1fdeg\n"
+          "lift height %.3fm, worst hard stop impact %.2frad/s\n"
+          "worst tipping %.2f\n"
+          "battery %.2fV, %.1f%% charge\n"
+          "simulated %.1fs in %.2fms\n",
+          scheduler.isScheduled(routine) ? "still running" : "finished", finished / 1000.0,
+          world.chassis.x, world.chassis.y, world.chassis.heading * 180 / M_PI,
+          world.lift.height(), world.lift.worstImpact,
+          world.chassis.worstTipping,
+          world.battery.voltage(), world.battery.charge() * 100,
+          AUTON_LENGTH / 1000.0, elapsed);
+  return 0;
+}
@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Checks that the lift's speed envelope keeps it from slamming into either end of its
+ * travel, against the simulated robot.
+ *
+ * The lift stick wanders, jumps to full travel and comes back to rest at random, and
+ * now and then a preset button is pressed, over a number of random traces.  Each trace
+ * runs with the envelope on and off, counting the times the lift hit a hard stop
+ * faster than _SLAM_H_IMPACT and the hardest hit.  Separately, the lift is driven at
+ * full stick from the floor to the top and back, timing each way, so that the
+ * envelope can be seen not to slow down a cycle.
+ *
+ * The check fails (exit status 1) if the lift slams with the envelope on, or if a full
+ * cycle up and back down takes more than _SLAM_H_STROKE longer with it than without.
+ * The down stroke on its own is always slower with the envelope, since without it the
+ * lift just falls into the floor.
+ *
+ * Usage:
+ *    build/slam [-n traces] [-s seed] [-f file]
+ *
+ *    -n    random traces to run, default 20, each TRACE long
+ *    -s    random seed
+ *    -f    read the configuration from this file (e.g. a copy of config.txt) instead
+ *          of using the compiled-in defaults
+ */
+
+#include "vex.h"
+#include "sim/World.h"
+#include "subsystems/RD4BLift.h"
+#include <math.h>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define TICK 25
+#define TRACE 60000
+
+// Longest a full stroke may be allowed to take, each way, in milliseconds.
+#define STROKE_TIMEOUT 5000
+
+// Hitting a hard stop slower than this (percent of motor free speed) is just the lift
+// coming to rest there, not a slam.
+#define _SLAM_H_IMPACT 40
+
+// Share a full cycle (a stroke up and back down) may slow down by with the envelope on.
+#define _SLAM_H_STROKE 0.15
+
+#define AxisInput(x)   ([&]() -> int32_t {return joystick.x.position();})
+#define ButtonInput(y) ([&]() -> bool    {return joystick.y.pressing();})
+
+struct Result {
+  int32_t slams;      // hard stops hit faster than _SLAM_H_IMPACT
+  double worst;       // hardest hit, in percent of motor free speed
+};
+
+// Joint speed (rad/s) of the simulated lift in percent of its motors' free speed.
+static double motorPercent(sim::World& world, double speed) {
+  return fabs(speed) * world.lift.gearing / world.motor(LIFT_LEFT_MOTOR_PORT).maxSpeed() * 100;
+}
+
+// Advance a tick, and count it if the lift hit a stop hard within it.
+static void step(sim::World& world, RD4BLift& lift, Result& result) {
+  lift.update();
+  world.lift.worstImpact = 0;
+  world.advance(TICK);
+  double impact = motorPercent(world, world.lift.worstImpact);
+  if(impact > _SLAM_H_IMPACT) result.slams++;
+  if(impact > result.worst) result.worst = impact;
+}
+
+/*
+ * The stick mostly wanders, sometimes jumps to full travel either way (where drivers
+ * really slam the lift) and sometimes comes back to rest; about every five seconds one
+ * of the presets is pressed.
+ */
+static Result trace(const Config& config, uint32_t seed, bool limited) {
+  sim::World world;
+  world.makeCurrent();
+  controller joystick = controller(primary);
+  sim::Controller& input = world.controllers[0];
+  RD4BLift lift(AxisInput(Axis2), ButtonInput(ButtonRight), ButtonInput(ButtonDown), ButtonInput(ButtonUp),
+                LIFT_LEFT_MOTOR_PORT, LIFT_RIGHT_MOTOR_PORT);
+  lift.configure(&config);
+  lift.prepare();
+  lift.useSoftLimits(limited);
+
+  std::mt19937 random(seed);
+  std::uniform_int_distribution<int32_t> percent(0, 99);
+  const sim::Button presets[] = { sim::RIGHT, sim::DOWN, sim::UP };
+  Result result = { 0, 0 };
+  int32_t& stick = input.axis[1];
+  for(uint32_t t = 0; t < TRACE; t += TICK) {
+    int32_t roll = percent(random);
+    if(roll < 3) stick = percent(random) < 50 ? 100 : -100;
+    else if(roll < 5) stick = 0;
+    else if(roll < 8) stick = percent(random) * 2 - 99;
+    else if(stick != 0) stick = std::max(-100, std::min(100, stick + percent(random) % 11 - 5));
+    for(sim::Button button : presets) input.button[button] = false;
+    if(stick == 0 && percent(random) < 1) input.button[presets[percent(random) % 3]] = true;
+    step(world, lift, result);
+  }
+  return result;
+}
+
+// Milliseconds for a full stick stroke from the floor to the top, then back down.
+static void stroke(const Config& config, bool limited, uint32_t times[2], Result& result) {
+  sim::World world;
+  world.makeCurrent();
+  controller joystick = controller(primary);
+  sim::Controller& input = world.controllers[0];
+  RD4BLift lift(AxisInput(Axis2), LIFT_LEFT_MOTOR_PORT, LIFT_RIGHT_MOTOR_PORT);
+  lift.configure(&config);
+  lift.prepare();
+  lift.useSoftLimits(limited);
+
+  double ends[2] = { config.liftMaxHeight - config.liftTolerance, config.liftFloor + config.liftTolerance };
+  for(int i = 0; i < 2; i++) {
+    input.axis[1] = i == 0 ? 100 : -100;
+    times[i] = 0;
+    while(times[i] < STROKE_TIMEOUT && (i == 0 ? lift.getHeight() < ends[i] : lift.getHeight() > ends[i])) {
+      step(world, lift, result);
+      times[i] += TICK;
+    }
+    // Let it come to rest at the end before going back.
+    for(uint32_t t = 0; t < 500; t += TICK) step(world, lift, result);
+  }
+}
+
+int main(int argc, char** argv) {
+  Config config;
+  int32_t traces = 20;
+  uint32_t seed = 1;
+  int opt;
+  while((opt = getopt(argc, argv, "n:s:f:")) != -1) {
+    if(opt == 'n') traces = atoi(optarg);
+    else if(opt == 's') seed = (uint32_t) atoi(optarg);
+    else if(opt == 'f') {
+      // The stand-in SD card reads from a directory, so split the path into the two.
+      static char directory[256];
+      strncpy(directory, optarg, sizeof(directory) - 1);
+      char* slash = strrchr(directory, '/');
+      const char* name = slash == nullptr ? directory : slash + 1;
+      if(slash != nullptr) *slash = '\0';
+      sim::World world;
+      world.sdcard = slash == nullptr ? "." : directory;
+      world.makeCurrent();
+      if(config.load(name) < 0) {
+        fprintf(stderr, "couldn't read %s\n", optarg);
+        return 2;
+      }
+    } else {
+      fprintf(stderr, "usage: %s [-n traces] [-s seed] [-f file]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  Result limited = { 0, 0 }, unlimited = { 0, 0 };
+  for(int32_t i = 0; i < traces; i++) {
+    Result on = trace(config, seed + i, true);
+    Result off = trace(config, seed + i, false);
+    limited.slams += on.slams;
+    unlimited.slams += off.slams;
+    limited.worst = std::max(limited.worst, on.worst);
+    unlimited.worst = std::max(unlimited.worst, off.worst);
+  }
+
+  uint32_t limitedStroke[2], unlimitedStroke[2];
+  stroke(config, true, limitedStroke, limited);
+  stroke(config, false, unlimitedStroke, unlimited);
+
+  printf("%d traces of %ds, and a full stroke each way\n", (int) traces, TRACE / 1000);
+  printf("%-10s %6s %8s %8s %8s\n", "", "slams", "worst", "up", "down");
+  printf("%-10s %6d %7.0f%% %6ums %6ums\n", "envelope", (int) limited.slams, limited.worst,
+         (unsigned) limitedStroke[0], (unsigned) limitedStroke[1]);
+  printf("%-10s %6d %7.0f%% %6ums %6ums\n", "none", (int) unlimited.slams, unlimited.worst,
+         (unsigned) unlimitedStroke[0], (unsigned) unlimitedStroke[1]);
+
+  bool failed = false;
+  if(limited.slams > 0) {
+    printf("FAIL: the lift slams into a hard stop with the envelope on\n");
+    failed = true;
+  }
+  uint32_t limitedCycle = limitedStroke[0] + limitedStroke[1];
+  uint32_t unlimitedCycle = unlimitedStroke[0] + unlimitedStroke[1];
+  if(limitedStroke[0] >= STROKE_TIMEOUT || limitedStroke[1] >= STROKE_TIMEOUT ||
+     limitedCycle > unlimitedCycle * (1 + _SLAM_H_STROKE)) {
+    printf("FAIL: the envelope slows a full cycle down too much\n");
+    failed = true;
+  }
+  return failed ? 1 : 0;
+}
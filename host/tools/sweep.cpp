@@ -0,0 +1,407 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Sweeps the tuning constants in `Config` across a grid or a random sample, runs the
+ * subsystems against the simulated robot for every combination, and writes the best
+ * one out as a `Tuned.h`.
+ *
+ * Every run builds its own `sim::World`, `Config` and subsystems on whichever worker
+ * thread picks it up, and random samples are seeded from the run number, so runs are
+ * completely independent and the results don't depend on the number of threads.
+ *
+ * Each run goes through the same scripted scenario:
+ *  - drive: sticks jittering around the centre (drift), full forwards, then release;
+ *  - lift: lower tower preset, upper tower preset, then back to the ground;
+ *  - intake: intake a cube, then spit it back out.
+ * and is scored on settle time, overshoot, peak current, drift and how far the lift
+ * ended up from the heights we actually need.  Lower is better.
+ *
+ * Usage:
+ *    build/sweep [options]
+ *      -g N            grid search, N steps per parameter
+ *      -r N            random search, N samples (default 2000)
+ *      -j N            worker threads (default: every core)
+ *      -s N            random seed (default 1)
+ *      -p name=lo:hi   sweep `name` over lo...hi; only listed parameters are swept,
+ *                      or all of them if none are listed
+ *      -l metres       lift height wanted at the lower tower preset (default 0.40)
+ *      -u metres       lift height wanted at the upper tower preset (default 0.55)
+ *      -o file         write the best parameters to `file` as a Tuned.h
+ */
+
+#include "vex.h"
+#include "Config.h"
+#include "sim/World.h"
+#include "subsystems/MecanumDriveTank.h"
+#include "subsystems/RD4BLift.h"
+#include "subsystems/RollerIntake.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <math.h>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+// Robot tick, and how often the scenario samples the simulation in between.
+#define TICK 25
+#define SAMPLE 5
+
+// Weights of each term of the cost.
+#define COST_SETTLE 1.0        // per second
+#define COST_OVERSHOOT 2.0     // per unit fraction of the step
+#define COST_DRIFT 20.0        // per metre
+#define COST_DEADBAND 0.02     // per percent of stick travel thrown away
+#define COST_CURRENT 0.5       // per unit fraction of the current limit
+#define COST_HEIGHT 20.0       // per metre off the wanted preset height
+#define COST_UNSETTLED 3.0     // flat, for a preset that never settles
+#define COST_ROLLER 2.0        // per unit fraction of roller speed short of free speed
+
+/*
+ * Parameters that can be swept, and where they go in `Config` and `Tuned.h`.
+ */
+struct Parameter {
+  const char* name;
+  const char* macro;
+  double min, max;
+  bool integer;
+  void (*apply)(Config& config, double value);
+};
+
+static Parameter parameters[] = {
+  { "driveDeadband",   "_MDT_H_DEADBAND",          0,   15,  true,
+    [](Config& c, double v) { c.driveDeadband = (int32_t) v; } },
+  { "liftDeadband",    "_RD4BLIFT_H_DBAND",        0,   15,  true,
+    [](Config& c, double v) { c.liftDeadband = (int32_t) v; } },
+  { "rollerPower",     "_ROLLER_H_POWER",          40,  100, true,
+    [](Config& c, double v) { c.rollerPower = (int32_t) v; } },
+  { "liftLowerTower",  "_RD4BLIFT_H_LOWER_TOWER",  0.5, 2.0, false,
+    [](Config& c, double v) { c.liftLowerTower = v; } },
+  { "liftUpperTower",  "_RD4BLIFT_H_UPPER_TOWER",  1.0, 2.2, false,
+    [](Config& c, double v) { c.liftUpperTower = v; } },
+  { "liftPresetSpeed", "_RD4BLIFT_H_PRESET_SPEED", 20,  100, true,
+    [](Config& c, double v) { c.liftPresetSpeed = (int32_t) v; } },
+};
+static const int parameterCount = sizeof(parameters) / sizeof(parameters[0]);
+
+struct Result {
+  double values[sizeof(parameters) / sizeof(parameters[0])];
+  double cost;
+  double driveSettle, driveOvershoot, drift, liftSettle, liftError, peakCurrent, rollerSpeed;
+};
+
+// Options shared by every run.
+static double lowerHeight = 0.40, upperHeight = 0.55;
+
+// Time after which `trace` stays within `band` of `target` for good, or -1.
+static double settleTime(const std::vector<double>& trace, double target, double band) {
+  for(int i = (int) trace.size() - 1; i >= 0; i--) {
+    if(fabs(trace[i] - target) > band) return i + 1 < (int) trace.size() ? (i + 1) * SAMPLE / 1000.0 : -1;
+  }
+  return 0;
+}
+
+/*
+ * Runs the scenario against a fresh world, with `values` applied on top of the
+ * compiled-in defaults.
+ */
+static void run(const double* values, Result& result) {
+  sim::World world;
+  world.makeCurrent();
+  sim::Controller& input = world.controllers[0];
+
+  Config config;
+  for(int i = 0; i < parameterCount; i++) parameters[i].apply(config, values[i]);
+
+  controller joystick = controller(primary);
+  MecanumDriveTank drive( [&]() -> int32_t { return joystick.Axis3.position(); },
+                          [&]() -> int32_t { return joystick.Axis2.position(); },
+                          [&]() -> int32_t { return joystick.Axis4.position(); },
+                          [&]() -> bool { return joystick.ButtonB.pressing(); },
+                          FRONT_RIGHT_MOTOR_PORT, FRONT_LEFT_MOTOR_PORT,
+                          BACK_RIGHT_MOTOR_PORT, BACK_LEFT_MOTOR_PORT );
+  RD4BLift lift( [&]() -> int32_t { return joystick.Axis1.position(); },
+                 [&]() -> bool { return joystick.ButtonDown.pressing(); },
+                 [&]() -> bool { return joystick.ButtonRight.pressing(); },
+                 [&]() -> bool { return joystick.ButtonUp.pressing(); },
+                 LIFT_LEFT_MOTOR_PORT, LIFT_RIGHT_MOTOR_PORT );
+  RollerIntake intake( [&]() -> bool { return joystick.ButtonR1.pressing(); },
+                       [&]() -> bool { return joystick.ButtonR2.pressing(); },
+                       ROLLER_LEFT_MOTOR_PORT, ROLLER_RIGHT_MOTOR_PORT );
+  Subsystem* subsystems[3] = { &drive, &lift, &intake };
+  for(Subsystem* subsystem : subsystems) {
+    subsystem->configure(&config);
+    subsystem->prepare();
+  }
+
+  // Run for `ms`, ticking the subsystems every TICK and calling `sample` every SAMPLE.
+  auto simulate = [&](uint32_t ms, std::function<void(uint32_t)> sample) {
+    for(uint32_t t = 0; t < ms; t += SAMPLE) {
+      if(t % TICK == 0) for(Subsystem* subsystem : subsystems) subsystem->update();
+      world.advance(SAMPLE);
+      sample(t);
+    }
+  };
+
+  // Drive: stick drift first.  The jitter is the same for every run.
+  std::mt19937 jitter(7);
+  std::uniform_int_distribution<int32_t> noise(-6, 6);
+  auto drift = [&](uint32_t t) {
+    if(t % TICK == 0) for(int i = 1; i < 4; i++) input.axis[i] = noise(jitter);
+  };
+  simulate(1000, drift);
+  result.drift = hypot(world.chassis.x, world.chassis.y);
+
+  // Then full forwards.
+  std::vector<double> speed;
+  input.axis[2] = 100;
+  input.axis[1] = 100;
+  input.axis[3] = 0;
+  simulate(1500, [&](uint32_t t) { speed.push_back(world.chassis.forwardSpeed); });
+  double final = 0;
+  for(size_t i = speed.size() - 40; i < speed.size(); i++) final += speed[i] / 40;
+  double settle = settleTime(speed, final, 0.05 * fabs(final));
+  result.driveSettle = settle < 0 ? 1.5 : settle;
+  double fastest = *std::max_element(speed.begin(), speed.end());
+  result.driveOvershoot = final > 0 ? std::max(0.0, fastest - final) / final : 1;
+  simulate(1500, drift);
+
+  // Lift: each preset in turn, held for three seconds.  The drive always hits the
+  // current limit on a full-stick step, so only the lift's peak current is scored.
+  for(int i = 1; i < 4; i++) input.axis[i] = 0;
+  sim::Motor& liftMotor = world.motor(LIFT_LEFT_MOTOR_PORT);
+  double peakCurrent = 0;
+  struct { bool* button; double wanted; } presets[3] = {
+    { &input.button[sim::RIGHT], lowerHeight },
+    { &input.button[sim::UP], upperHeight },
+    { &input.button[sim::DOWN], 0 }
+  };
+  result.liftSettle = 0;
+  result.liftError = 0;
+  for(auto& preset : presets) {
+    std::vector<double> height;
+    *preset.button = true;
+    simulate(3000, [&](uint32_t t) {
+      if(t == TICK) *preset.button = false;
+      height.push_back(world.lift.height());
+      peakCurrent = std::max(peakCurrent, liftMotor.getCurrent());
+    });
+    double settle = settleTime(height, height.back(), 0.01);
+    result.liftSettle += settle < 0 ? COST_UNSETTLED : settle;
+    result.liftError += fabs(height.back() - preset.wanted);
+  }
+
+  // Intake: a cube in the rollers, intake for a second then outtake for a second.
+  world.intake.cubeLoad = 0.3;
+  double rollerSpeed = 0;
+  int samples = 0;
+  input.button[sim::R1] = true;
+  simulate(1000, [&](uint32_t t) {
+    if(t >= 250) {
+      rollerSpeed += fabs(world.intake.speed[0]) / world.motor(ROLLER_LEFT_MOTOR_PORT).maxSpeed();
+      samples++;
+    }
+  });
+  input.button[sim::R1] = false;
+  input.button[sim::R2] = true;
+  simulate(1000, [](uint32_t t) {});
+  result.rollerSpeed = rollerSpeed / samples;
+  result.peakCurrent = peakCurrent;
+
+  result.cost = COST_SETTLE * (result.driveSettle + result.liftSettle)
+              + COST_OVERSHOOT * result.driveOvershoot
+              + COST_DRIFT * result.drift
+              + COST_DEADBAND * (config.driveDeadband + config.liftDeadband)
+              + COST_CURRENT * peakCurrent / 2.5
+              + COST_HEIGHT * result.liftError
+              + COST_ROLLER * (1 - result.rollerSpeed);
+}
+
+static void usage() {
+  fprintf(stderr, "usage: sweep [-g steps | -r samples] [-j threads] [-s seed] [-p name=lo:hi]... "
+                  "[-l metres] [-u metres] [-o file]\n");
+  exit(1);
+}
+
+// Write `values` out as a Tuned.h.
+static bool writeHeader(const char* path, const double* values, const bool* swept, const Result& best, int runs) {
+  FILE* file = fopen(path, "w");
+  if(file == nullptr) return false;
+  fprintf(file,
+    "/*\n"
+    " * Copyright (c) 2019 Brandon Gong\n"
+    " *\n"
+    " * Permission is hereby granted, free of charge, to any person obtaining a copy\n"
+    " * of this software and associated documentation files (the \"Software\"), to deal\n"
+    " * in the Software without restriction, including without limitation the rights\n"
+    " * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell\n"
+    " * copies of the Software, and to permit persons to whom the Software is\n"
+    " * furnished to do so, subject to the following conditions:\n"
+    " *\n"
+    " * The above copyright notice and this permission notice shall be included in\n"
+    " * all copies or substantial portions of the Software.\n"
+    " *\n"
+    " * THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR\n"
+    " * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,\n"
+    " * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE\n"
+    " * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER\n"
+    " * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,\n"
+    " * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN\n"
+    " * THE SOFTWARE.\n"
+    " */\n"
+    "\n"
+    "/**\n"
+    " * Overrides for the compiled-in tuning constants.  Anything #defined here replaces the\n"
+    " * default of the same name in the subsystem headers.\n"
+    " *\n"
+    " * Generated by the host parameter sweep: best of %d runs, cost %.3f.\n"
+    " */\n"
+    "#ifndef _TUNED_H_\n"
+    "#define _TUNED_H_\n\n", runs, best.cost);
+  for(int i = 0; i < parameterCount; i++) {
+    if(!swept[i]) continue;
+    if(parameters[i].integer) fprintf(file, "#define %s %d\n", parameters[i].macro, (int) values[i]);
+    else fprintf(file, "#define %s %.3f\n", parameters[i].macro, values[i]);
+  }
+  fprintf(file, "\n#endif\n");
+  fclose(file);
+  return true;
+}
+
+int main(int argc, char** argv) {
+  int grid = 0, samples = 2000, threads = std::thread::hardware_concurrency();
+  unsigned seed = 1;
+  const char* output = nullptr;
+  bool swept[parameterCount] = {};
+  bool anySwept = false;
+
+  for(int i = 1; i < argc; i++) {
+    if(argv[i][0] != '-' || argv[i][1] == '\0' || argv[i][2] != '\0' || i + 1 >= argc) usage();
+    const char* value = argv[++i];
+    switch(argv[i - 1][1]) {
+      case 'g': grid = atoi(value); break;
+      case 'r': samples = atoi(value); grid = 0; break;
+      case 'j': threads = atoi(value); break;
+      case 's': seed = (unsigned) atoi(value); break;
+      case 'l': lowerHeight = atof(value); break;
+      case 'u': upperHeight = atof(value); break;
+      case 'o': output = value; break;
+      case 'p': {
+        const char* equals = strchr(value, '=');
+        int found = -1;
+        for(int j = 0; equals != nullptr && j < parameterCount; j++) {
+          if(strncmp(parameters[j].name, value, equals - value) == 0
+             && strlen(parameters[j].name) == (size_t) (equals - value)) found = j;
+        }
+        if(found < 0 || sscanf(equals + 1, "%lf:%lf", &parameters[found].min, &parameters[found].max) != 2) {
+          fprintf(stderr, "unknown or malformed parameter '%s'\n", value);
+          usage();
+        }
+        swept[found] = anySwept = true;
+        break;
+      }
+      default: usage();
+    }
+  }
+  if(!anySwept) for(int i = 0; i < parameterCount; i++) swept[i] = true;
+  if(threads < 1) threads = 1;
+
+  // Work out the total number of runs.
+  int sweptCount = 0;
+  for(int i = 0; i < parameterCount; i++) sweptCount += swept[i];
+  int runs = samples;
+  if(grid > 0) {
+    if(grid < 2) grid = 2;
+    runs = 1;
+    for(int i = 0; i < sweptCount; i++) runs *= grid;
+  }
+
+  // Defaults for anything that isn't swept.
+  Config defaults;
+  double base[parameterCount] = { (double) defaults.driveDeadband, (double) defaults.liftDeadband,
+                                  (double) defaults.rollerPower, defaults.liftLowerTower,
+                                  defaults.liftUpperTower, (double) defaults.liftPresetSpeed };
+
+  // Values for run `index`.  Only depends on the index, never on which thread asks.
+  auto valuesFor = [&](int index, double* values) {
+    std::mt19937 random(seed * 1000003u + index);
+    int rest = index;
+    for(int i = 0; i < parameterCount; i++) {
+      values[i] = base[i];
+      if(!swept[i]) continue;
+      const Parameter& p = parameters[i];
+      if(grid > 0) {
+        values[i] = p.min + (p.max - p.min) * (rest % grid) / (grid - 1);
+        rest /= grid;
+      } else {
+        values[i] = std::uniform_real_distribution<double>(p.min, p.max)(random);
+      }
+      if(p.integer) values[i] = round(values[i]);
+    }
+  };
+
+  std::vector<Result> results(runs);
+  std::atomic<int> next(0);
+  auto started = std::chrono::steady_clock::now();
+
+  std::vector<std::thread> workers;
+  for(int t = 0; t < threads; t++) {
+    workers.push_back(std::thread([&]() {
+      for(int index = next++; index < runs; index = next++) {
+        valuesFor(index, results[index].values);
+        run(results[index].values, results[index]);
+      }
+    }));
+  }
+  for(std::thread& worker : workers) worker.join();
+
+  double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+  std::vector<int> order(runs);
+  for(int i = 0; i < runs; i++) order[i] = i;
+  std::sort(order.begin(), order.end(), [&](int a, int b) { return results[a].cost < results[b].cost; });
+
+  printf("%d runs on %d threads in %.2fs (%.1f runs/s)\n\n", runs, threads, elapsed, runs / elapsed);
+  for(int i = 0; i < parameterCount; i++) printf("%16s", parameters[i].name);
+  printf("%10s%10s%10s%10s%10s%10s%10s%10s\n",
+         "cost", "settle", "overshoot", "drift", "lift", "liftErr", "peakA", "roller");
+  for(int rank = 0; rank < runs && rank < 10; rank++) {
+    const Result& r = results[order[rank]];
+    for(int i = 0; i < parameterCount; i++) printf(parameters[i].integer ? "%16.0f" : "%16.3f", r.values[i]);
+    printf("%10.3f%10.3f%10.3f%10.4f%10.3f%10.3f%10.2f%10.2f\n",
+           r.cost, r.driveSettle, r.driveOvershoot, r.drift, r.liftSettle, r.liftError, r.peakCurrent, r.rollerSpeed);
+  }
+
+  if(output != nullptr && runs > 0) {
+    const Result& best = results[order[0]];
+    if(!writeHeader(output, best.values, swept, best, runs)) {
+      fprintf(stderr, "couldn't write %s\n", output);
+      return 1;
+    }
+    printf("\nwrote %s\n", output);
+  }
+  return 0;
+}
@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Fits the `Feedforward` constants of the drive base or the lift to a characterization
+ * log recorded by `SysId` (sysid.csv on the robot's SD card), by least squares on
+ *
+ *    volts = kS * sign(speed) + kV * speed + kA * acceleration [+ kG for the lift]
+ *
+ * with speed in percent and acceleration in percent per second, the same units the
+ * robot's `Feedforward` uses.  Acceleration is the slope of the speed across a few
+ * samples either side.  Samples at rest, where the sign of the speed (and so kS) means
+ * nothing, are left out.
+ *
+ * Prints the constants as lines for config.txt, or with -d as #defines to paste into
+ * the subsystem's header, along with how well they fit.
+ *
+ * Usage:
+ *    build/sysid [-d] sysid.csv     fit a log from the robot
+ *    build/sysid [-d] -s drive      characterize the simulated drive base, then fit it
+ *    build/sysid [-d] -s lift       characterize the simulated lift, then fit it
+ *
+ *    -d    print #defines instead of config lines
+ *    -w    with -s, also save the simulated log to sysid.csv in this directory, the
+ *          same way the robot saves it
+ */
+
+#include "vex.h"
+#include "sim/World.h"
+#include "subsystems/MecanumDriveTank.h"
+#include "subsystems/RD4BLift.h"
+#include "commands/Scheduler.h"
+#include "commands/SysIdCommand.h"
+#include "SysId.h"
+#include "Sensing.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+// Tick of the control loop on the robot, in milliseconds.
+#define TICK 25
+
+// Longest the simulated characterization may take, in milliseconds.
+#define SIM_LENGTH 60000
+
+// Samples slower than this (percent) are left out of the fit.
+#define MIN_SPEED 1
+
+// Acceleration is taken across this many samples either side.
+#define SLOPE_SPAN 2
+
+// Most unknowns in the fit: kS, kV, kA and kG.
+#define TERMS 4
+
+#define AxisInput(x)   ([&]() -> int32_t {return joystick.x.position();})
+#define ButtonInput(y) ([&]() -> bool    {return joystick.y.pressing();})
+
+static SysId::Sample samples[_SYSID_H_SAMPLES];
+static uint32_t sampleCount = 0;
+
+/*
+ * Runs the same characterization routine as the robot does with RUN_SYSID, and copies
+ * the recorded samples out.  Tasks don't run on the host, so the recorder is sampled
+ * and the scheduler ticked from here.
+ */
+static bool simulate(SysId::Mechanism mechanism, bool write) {
+  sim::World world;
+  if(write) world.sdcard = ".";
+  world.makeCurrent();
+  controller joystick = controller(primary);
+
+  RD4BLift lift([]() -> int32_t { return 0; }, LIFT_LEFT_MOTOR_PORT, LIFT_RIGHT_MOTOR_PORT);
+  MecanumDriveTank drive(AxisInput(Axis3), AxisInput(Axis2), AxisInput(Axis4), ButtonInput(ButtonB),
+                         FRONT_RIGHT_MOTOR_PORT, FRONT_LEFT_MOTOR_PORT,
+                         BACK_RIGHT_MOTOR_PORT, BACK_LEFT_MOTOR_PORT);
+  Subsystem* subsystems[2] = { &lift, &drive };
+  for(Subsystem* subsystem : subsystems) subsystem->prepare();
+  Scheduler scheduler(subsystems, 2);
+  Sensing sensing;
+
+  static SysId driveSysId(&drive), liftSysId(&lift);
+  SysId* sysid = mechanism == SysId::Mechanism::DRIVE ? &driveSysId : &liftSysId;
+
+  Command* routine = buildCharacterization(sysid, &lift);
+  if(!scheduler.schedule(routine)) return false;
+  for(uint32_t t = 0; t < SIM_LENGTH && scheduler.isScheduled(routine); t += _SYSID_H_PERIOD) {
+    if(t % TICK == 0) {
+      sensing.update();
+      scheduler.update();
+    }
+    world.advance(_SYSID_H_PERIOD);
+    sysid->sample();
+  }
+
+  sampleCount = sysid->getSampleCount();
+  for(uint32_t i = 0; i < sampleCount; i++) samples[i] = sysid->getSample(i);
+  fprintf(stderr, "simulated %u samples in %.1fs\n", (unsigned) sampleCount, world.micros() / 1e6);
+  if(write) sysid->save();
+  return true;
+}
+
+// Read a log written by `SysId::save()`.  Returns false if the file can't be read.
+static bool load(const char* name, SysId::Mechanism& mechanism) {
+  FILE* file = fopen(name, "r");
+  if(file == nullptr) return false;
+
+  char line[256];
+  mechanism = SysId::Mechanism::DRIVE;
+  while(fgets(line, sizeof(line), file) != nullptr && sampleCount < _SYSID_H_SAMPLES) {
+    if(strncmp(line, "# lift", 6) == 0) mechanism = SysId::Mechanism::LIFT;
+    unsigned test, time;
+    float volts, speed, position;
+    if(sscanf(line, "%u,%u,%f,%f,%f", &test, &time, &volts, &speed, &position) != 5) continue;
+    SysId::Sample& sample = samples[sampleCount++];
+    sample.test = (uint8_t) test;
+    sample.time = time;
+    sample.volts = volts;
+    sample.speed = speed;
+    sample.position = position;
+  }
+  fclose(file);
+  return true;
+}
+
+// Solve `a x = b` for `n` unknowns by Gaussian elimination.  Returns false if singular.
+static bool solve(double a[TERMS][TERMS], double b[TERMS], double x[TERMS], int n) {
+  for(int col = 0; col < n; col++) {
+    int pivot = col;
+    for(int row = col + 1; row < n; row++) {
+      if(fabs(a[row][col]) > fabs(a[pivot][col])) pivot = row;
+    }
+    if(fabs(a[pivot][col]) < 1e-12) return false;
+    for(int k = 0; k < n; k++) {
+      double swap = a[col][k]; a[col][k] = a[pivot][k]; a[pivot][k] = swap;
+    }
+    double swap = b[col]; b[col] = b[pivot]; b[pivot] = swap;
+    for(int row = col + 1; row < n; row++) {
+      double factor = a[row][col] / a[col][col];
+      for(int k = col; k < n; k++) a[row][k] -= factor * a[col][k];
+      b[row] -= factor * b[col];
+    }
+  }
+  for(int row = n - 1; row >= 0; row--) {
+    double sum = b[row];
+    for(int k = row + 1; k < n; k++) sum -= a[row][k] * x[k];
+    x[row] = sum / a[row][row];
+  }
+  return true;
+}
+
+// The regressors for sample `i`, or false if it should be left out of the fit.
+static bool terms(uint32_t i, int n, double row[TERMS]) {
+  if(i < SLOPE_SPAN || i + SLOPE_SPAN >= sampleCount) return false;
+  const SysId::Sample& before = samples[i - SLOPE_SPAN];
+  const SysId::Sample& sample = samples[i];
+  const SysId::Sample& after = samples[i + SLOPE_SPAN];
+  if(before.test != sample.test || after.test != sample.test || after.time <= before.time) return false;
+  if(fabs(sample.speed) < MIN_SPEED) return false;
+
+  row[0] = sample.speed > 0 ? 1 : -1;
+  row[1] = sample.speed;
+  row[2] = (after.speed - before.speed) / ((after.time - before.time) / 1e6);
+  if(n > 3) row[3] = 1;
+  return true;
+}
+
+int main(int argc, char** argv) {
+  bool defines = false, write = false;
+  const char* simulated = nullptr;
+  int opt;
+  while((opt = getopt(argc, argv, "dws:")) != -1) {
+    if(opt == 'd') defines = true;
+    else if(opt == 'w') write = true;
+    else if(opt == 's') simulated = optarg;
+    else {
+      fprintf(stderr, "usage: %s [-d] (file | [-w] -s drive|lift)\n", argv[0]);
+      return 2;
+    }
+  }
+
+  SysId::Mechanism mechanism;
+  if(simulated != nullptr) {
+    mechanism = strcmp(simulated, "lift") == 0 ? SysId::Mechanism::LIFT : SysId::Mechanism::DRIVE;
+    if(!simulate(mechanism, write)) {
+      fprintf(stderr, "couldn't start the characterization\n");
+      return 2;
+    }
+  } else if(optind < argc) {
+    if(!load(argv[optind], mechanism)) {
+      fprintf(stderr, "couldn't read %s\n", argv[optind]);
+      return 2;
+    }
+  } else {
+    fprintf(stderr, "usage: %s [-d] (file | [-w] -s drive|lift)\n", argv[0]);
+    return 2;
+  }
+
+  // Only the lift has gravity to hold up, so only it gets a constant term.
+  int n = mechanism == SysId::Mechanism::LIFT ? 4 : 3;
+
+  // Least squares through the normal equations; with at most four unknowns there is
+  // nothing to gain from anything more careful.
+  double ata[TERMS][TERMS] = {{0}}, atb[TERMS] = {0};
+  double sum = 0, sumSquares = 0;
+  uint32_t used = 0;
+  for(uint32_t i = 0; i < sampleCount; i++) {
+    double row[TERMS];
+    if(!terms(i, n, row)) continue;
+    for(int j = 0; j < n; j++) {
+      for(int k = 0; k < n; k++) ata[j][k] += row[j] * row[k];
+      atb[j] += row[j] * samples[i].volts;
+    }
+    sum += samples[i].volts;
+    sumSquares += samples[i].volts * samples[i].volts;
+    used++;
+  }
+
+  double k[TERMS] = {0};
+  if(used < (uint32_t) n * 10 || !solve(ata, atb, k, n)) {
+    fprintf(stderr, "not enough moving samples to fit (%u of %u)\n", (unsigned) used, (unsigned) sampleCount);
+    return 1;
+  }
+
+  // How much of the variation in voltage the model explains.
+  double residual = 0;
+  for(uint32_t i = 0; i < sampleCount; i++) {
+    double row[TERMS];
+    if(!terms(i, n, row)) continue;
+    double predicted = 0;
+    for(int j = 0; j < n; j++) predicted += k[j] * row[j];
+    residual += (samples[i].volts - predicted) * (samples[i].volts - predicted);
+  }
+  double mean = sum / used;
+  double total = sumSquares - used * mean * mean;
+  double r2 = total > 0 ? 1 - residual / total : 0;
+
+  bool drive = mechanism == SysId::Mechanism::DRIVE;
+  printf("# %s, fitted to %u of %u samples, r^2 %.4f, rms error %.3fV\n",
+         drive ? "drive" : "lift", (unsigned) used, (unsigned) sampleCount, r2, sqrt(residual / used));
+  static const char* names[TERMS] = { "kS", "kV", "kA", "kG" };
+  static const char* suffixes[TERMS] = { "KS", "KV", "KA", "KG" };
+  for(int j = 0; j < n; j++) {
+    if(defines) printf("#define %s_%s %.4g\n", drive ? "_MDT_H" : "_RD4BLIFT_H", suffixes[j], k[j]);
+    else printf("%s.%s = %.4g\n", drive ? "driveModel" : "liftModel", names[j], k[j]);
+  }
+  return 0;
+}
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Checks the lift-height drive limits against the simulated robot.
+ *
+ * With the lift held at each preset, the driver slams the sticks through full
+ * forward, full reverse and a strafe each way.  The robot runs once with the drive
+ * limits from the configuration and once without any.  Each run reports the worst
+ * tipping ratio (over 1 means the robot went over) and how far the first full-forward
+ * push got.
+ *
+ * The check fails (exit status 1) if the limited robot tips at any height, or if the
+ * limits cost any distance with the lift on the ground.
+ *
+ * Usage:
+ *    build/tipping [-f file]
+ *
+ *    -f    read the configuration from this file (e.g. a copy of config.txt) instead
+ *          of using the compiled-in defaults
+ */
+
+#include "vex.h"
+#include "sim/World.h"
+#include "subsystems/MecanumDriveTank.h"
+#include "subsystems/RD4BLift.h"
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#define TICK 25
+
+// How long the lift gets to reach its preset, and how long each stick input is held.
+#define SETTLE 2500
+#define HOLD 1500
+
+#define AxisInput(x)   ([&]() -> int32_t {return joystick.x.position();})
+#define ButtonInput(y) ([&]() -> bool    {return joystick.y.pressing();})
+
+struct Result {
+  double tipping;    // worst tipping ratio while driving
+  double distance;   // metres covered by the first full-forward push
+};
+
+// Stick positions for each part of the pattern: left, right, strafe.
+static const int32_t pattern[][3] = {
+  { 100,  100,    0 },
+  {-100, -100,    0 },
+  {   0,    0,  100 },
+  {   0,    0, -100 },
+  {   0,    0,    0 },
+};
+
+static Result run(const Config& config, RD4BLift::State preset, bool limited) {
+  sim::World world;
+  world.makeCurrent();
+  controller joystick = controller(primary);
+  sim::Controller& input = world.controllers[0];
+
+  RD4BLift lift([]() -> int32_t { return 0; }, LIFT_LEFT_MOTOR_PORT, LIFT_RIGHT_MOTOR_PORT);
+  MecanumDriveTank drive(AxisInput(Axis3), AxisInput(Axis2), AxisInput(Axis4), ButtonInput(ButtonB),
+                         FRONT_RIGHT_MOTOR_PORT, FRONT_LEFT_MOTOR_PORT,
+                         BACK_RIGHT_MOTOR_PORT, BACK_LEFT_MOTOR_PORT);
+  lift.configure(&config);
+  drive.configure(&config);
+  lift.prepare();
+  drive.prepare();
+  drive.useFeedforward(true);
+  if(limited) drive.setLiftHeight([&]() -> double { return lift.getHeight(); });
+
+  lift.setState(preset);
+  for(uint32_t t = 0; t < SETTLE; t += TICK) {
+    lift.update();
+    drive.update();
+    world.advance(TICK);
+  }
+
+  Result result;
+  world.chassis.worstTipping = 0;
+  double start = world.chassis.y;
+  for(const int32_t* sticks : pattern) {
+    input.axis[2] = sticks[0];
+    input.axis[1] = sticks[1];
+    input.axis[3] = sticks[2];
+    for(uint32_t t = 0; t < HOLD; t += TICK) {
+      lift.update();
+      drive.update();
+      world.advance(TICK);
+    }
+    if(sticks == pattern[0]) result.distance = world.chassis.y - start;
+  }
+  result.tipping = world.chassis.worstTipping;
+  return result;
+}
+
+int main(int argc, char** argv) {
+  Config config;
+  int opt;
+  while((opt = getopt(argc, argv, "f:")) != -1) {
+    if(opt != 'f') {
+      fprintf(stderr, "usage: %s [-f file]\n", argv[0]);
+      return 2;
+    }
+    // The stand-in SD card reads from a directory, so split the path into the two.
+    static char directory[256];
+    strncpy(directory, optarg, sizeof(directory) - 1);
+    char* slash = strrchr(directory, '/');
+    const char* name = slash == nullptr ? directory : slash + 1;
+    if(slash != nullptr) *slash = '\0';
+    sim::World world;
+    world.sdcard = slash == nullptr ? "." : directory;
+    world.makeCurrent();
+    if(config.load(name) < 0) {
+      fprintf(stderr, "couldn't read %s\n", optarg);
+      return 2;
+    }
+  }
+
+  struct { RD4BLift::State state; const char* name; } presets[] = {
+    { RD4BLift::State::GROUND,      "ground" },
+    { RD4BLift::State::LOWER_TOWER, "lower tower" },
+    { RD4BLift::State::UPPER_TOWER, "upper tower" },
+  };
+
+  bool failed = false;
+  printf("%-12s  %20s  %20s\n", "", "limited", "unlimited");
+  printf("%-12s  %9s %10s  %9s %10s\n", "lift", "tipping", "distance", "tipping", "distance");
+  for(auto& preset : presets) {
+    Result limited = run(config, preset.state, true);
+    Result unlimited = run(config, preset.state, false);
+    printf("%-12s  %9.2f %9.3fm  %9.2f %9.3fm\n", preset.name,
+           limited.tipping, limited.distance, unlimited.tipping, unlimited.distance);
+
+    if(limited.tipping >= 1) {
+      printf("FAIL: tips over with the lift at %s\n", preset.name);
+      failed = true;
+    }
+    if(preset.state == RD4BLift::State::GROUND && limited.distance < unlimited.distance - 1e-6) {
+      printf("FAIL: limits slow the robot down with the lift on the ground\n");
+      failed = true;
+    }
+  }
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Checks the drive's traction control against the simulated robot.
+ *
+ * From rest, the driver slams the sticks to full forward, full twist or full strafe
+ * and holds them, once on even carpet and once with the front-left wheel on a
+ * slippery patch.  Each run is made with traction control on and off, and reports:
+ *  - slip: the wheels' average slip against the floor, in m/s;
+ *  - progress: metres covered, or degrees turned for the twist;
+ *  - drift: degrees the robot turned when it was meant to go straight;
+ *  - ns/tick: wall-clock time spent in `update()`.
+ *
+ * The check fails (exit status 1) if traction control slips more than without it in
+ * any run, gives up more than _TRACTION_PROGRESS of the progress, or drifts further.
+ *
+ * Usage:
+ *    build/traction [-f file]
+ *
+ *    -f    read the configuration from this file (e.g. a copy of config.txt) instead
+ *          of using the compiled-in defaults
+ */
+
+#include "vex.h"
+#include "sim/World.h"
+#include "subsystems/MecanumDriveTank.h"
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#define TICK 25
+#define HOLD 1500
+
+// Grip of the wheel on the slippery patch, as a share of the carpet's.
+#define SLICK_GRIP 0.3
+
+// Share of the progress traction control may give up, and drift (degrees) that counts
+// as none at all.
+#define _TRACTION_PROGRESS 0.05
+#define _TRACTION_DRIFT 0.5
+
+#define AxisInput(x)   ([&]() -> int32_t {return joystick.x.position();})
+#define ButtonInput(y) ([&]() -> bool    {return joystick.y.pressing();})
+
+struct Scenario {
+  const char* name;
+  int32_t left, right, strafe;  // stick positions
+  bool slick;                   // front-left wheel on the slippery patch
+  bool turning;                 // progress is degrees turned rather than metres
+};
+
+struct Result {
+  double slip, progress, drift, nanos;
+};
+
+static const Scenario scenarios[] = {
+  { "forward",        100,  100,   0, false, false },
+  { "twist",          100, -100,   0, false, true  },
+  { "strafe",           0,    0, 100, false, false },
+  { "slick forward",  100,  100,   0, true,  false },
+  { "slick twist",    100, -100,   0, true,  true  },
+  { "slick strafe",     0,    0, 100, true,  false },
+};
+
+static Result run(const Config& config, const Scenario& scenario, bool traction) {
+  sim::World world;
+  world.makeCurrent();
+  controller joystick = controller(primary);
+  sim::Controller& input = world.controllers[0];
+
+  MecanumDriveTank drive(AxisInput(Axis3), AxisInput(Axis2), AxisInput(Axis4), ButtonInput(ButtonB),
+                         FRONT_RIGHT_MOTOR_PORT, FRONT_LEFT_MOTOR_PORT,
+                         BACK_RIGHT_MOTOR_PORT, BACK_LEFT_MOTOR_PORT);
+  drive.configure(&config);
+  drive.prepare();
+  drive.useFeedforward(true);
+  drive.useTractionControl(traction);
+  if(scenario.slick) world.chassis.grip[0] = SLICK_GRIP;
+
+  input.axis[2] = scenario.left;
+  input.axis[1] = scenario.right;
+  input.axis[3] = scenario.strafe;
+
+  Result result = { 0, 0, 0, 0 };
+  uint32_t ticks = 0;
+  for(uint32_t t = 0; t < HOLD; t += TICK, ticks++) {
+    auto started = std::chrono::steady_clock::now();
+    drive.update();
+    result.nanos += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - started).count();
+    world.advance(TICK);
+    for(double slip : world.chassis.slip) result.slip += fabs(slip) / 4;
+  }
+
+  double degrees = fabs(world.chassis.heading) * 180 / M_PI;
+  result.slip /= ticks;
+  result.nanos /= ticks;
+  result.progress = scenario.turning ? degrees : hypot(world.chassis.x, world.chassis.y);
+  result.drift = scenario.turning ? 0 : degrees;
+  return result;
+}
+
+int main(int argc, char** argv) {
+  Config config;
+  int opt;
+  while((opt = getopt(argc, argv, "f:")) != -1) {
+    if(opt != 'f') {
+      fprintf(stderr, "usage: %s [-f file]\n", argv[0]);
+      return 2;
+    }
+    // The stand-in SD card reads from a directory, so split the path into the two.
+    static char directory[256];
+    strncpy(directory, optarg, sizeof(directory) - 1);
+    char* slash = strrchr(directory, '/');
+    const char* name = slash == nullptr ? directory : slash + 1;
+    if(slash != nullptr) *slash = '\0';
+    sim::World world;
+    world.sdcard = slash == nullptr ? "." : directory;
+    world.makeCurrent();
+    if(config.load(name) < 0) {
+      fprintf(stderr, "couldn't read %s\n", optarg);
+      return 2;
+    }
+  }
+
+  bool failed = false;
+  printf("%-14s  %32s  %32s\n", "", "traction control", "none");
+  printf("%-14s  %6s %9s %6s %8s  %6s %9s %6s %8s\n", "",
+         "slip", "progress", "drift", "ns/tick", "slip", "progress", "drift", "ns/tick");
+  for(const Scenario& scenario : scenarios) {
+    Result on = run(config, scenario, true);
+    Result off = run(config, scenario, false);
+    const char* unit = scenario.turning ? "deg" : "m";
+    printf("%-14s  %6.3f %6.2f%-3s %6.1f %8.0f  %6.3f %6.2f%-3s %6.1f %8.0f\n", scenario.name,
+           on.slip, on.progress, unit, on.drift, on.nanos, off.slip, off.progress, unit, off.drift, off.nanos);
+
+    if(on.slip > off.slip) {
+      printf("FAIL: slips more with traction control, %s\n", scenario.name);
+      failed = true;
+    }
+    if(on.progress < off.progress * (1 - _TRACTION_PROGRESS)) {
+      printf("FAIL: traction control costs too much progress, %s\n", scenario.name);
+      failed = true;
+    }
+    if(on.drift > off.drift && on.drift > _TRACTION_DRIFT) {
+      printf("FAIL: drifts further with traction control, %s\n", scenario.name);
+      failed = true;
+    }
+  }
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,380 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Turns a route description into trajectory tables for the robot to follow (see
+ * Trajectory.h), and writes them out as a header of constant data.
+ *
+ * A route file has one command per line; `#` starts a comment.
+ *
+ *    speed 0.5           top wheel speed from here on, in m/s
+ *    accel 1.0           top acceleration (and cornering acceleration), in m/s^2
+ *    trajectory NAME     start a new trajectory, named NAME in the header
+ *    point x y heading   a waypoint: field position in metres, and heading in degrees
+ *                        clockwise from +y
+ *
+ * Each trajectory starts at its first point and ends at its last, both at rest, and
+ * passes through the points in between on a smooth (Catmull-Rom) curve.  The heading
+ * turns steadily from each point's to the next, independently of the direction of
+ * travel, since the drive base is holonomic; two points in the same place turn on
+ * the spot.
+ *
+ * Speed is planned along the distance covered by the wheels rather than the robot,
+ * so that turning counts.  It is limited by the top speed (for the fastest wheel), by
+ * the acceleration along the path, and by the cornering acceleration on curves.  The
+ * drive base's dimensions come from the simulator, so they only have to be kept right
+ * in one place.
+ *
+ * Usage:
+ *    build/trajectory [-p period] [-o file] route
+ *
+ *    -p    milliseconds between points in the tables (default 50)
+ *    -o    write the header to this file instead of stdout
+ *
+ * `make -C host trajectories` regenerates include/Trajectories.h from autonomous.route.
+ */
+
+#include "vex.h"
+#include "sim/World.h"
+#include "Trajectory.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <vector>
+
+// Steps each section of curve between two waypoints is planned in.
+#define STEPS 500
+
+// Which way each wheel rolls for a clockwise turn, as in sim::Chassis.
+static const double turnSign[4] = { +1, -1, +1, -1 };
+
+struct Waypoint {
+  double x, y, heading;
+};
+
+struct Route {
+  char name[64];
+  double speed, accel;
+  std::vector<Waypoint> points;
+};
+
+// The drive base, from the simulator.
+struct Geometry {
+  double wheelRadius, lever, freeSpeed;
+  double strafeSign[4], motorSign[4];
+};
+
+// One step of the planned path.
+struct Node {
+  double x, y, heading;
+  double u;               // wheel distance from the start, metres
+  double wheel[4];        // wheel surface travel per metre of u, physical direction
+  double forward, strafe; // body-frame travel per metre of u
+  double turn;            // radians per metre of u
+  double speed;           // metres of u per second
+  double time;            // seconds
+  double position[4];     // wheel revolutions from the start, motor direction
+};
+
+static bool readRoutes(const char* path, std::vector<Route>& routes) {
+  FILE* file = fopen(path, "r");
+  if(file == nullptr) return false;
+
+  double speed = 0.5, accel = 1.0;
+  char line[256];
+  int number = 0;
+  bool ok = true;
+  while(fgets(line, sizeof(line), file) != nullptr) {
+    number++;
+    char* comment = strchr(line, '#');
+    if(comment != nullptr) *comment = '\0';
+
+    char command[32], name[64];
+    Waypoint point;
+    if(sscanf(line, "%31s", command) != 1) continue;
+    if(strcmp(command, "speed") == 0 && sscanf(line, "%*s %lf", &speed) == 1) continue;
+    if(strcmp(command, "accel") == 0 && sscanf(line, "%*s %lf", &accel) == 1) continue;
+    if(strcmp(command, "trajectory") == 0 && sscanf(line, "%*s %63s", name) == 1) {
+      routes.push_back(Route());
+      strcpy(routes.back().name, name);
+      continue;
+    }
+    if(strcmp(command, "point") == 0 && !routes.empty()
+       && sscanf(line, "%*s %lf %lf %lf", &point.x, &point.y, &point.heading) == 3) {
+      point.heading *= M_PI / 180;
+      routes.back().points.push_back(point);
+      routes.back().speed = speed;
+      routes.back().accel = accel;
+      continue;
+    }
+    fprintf(stderr, "%s:%d: can't read \"%s\"\n", path, number, command);
+    ok = false;
+  }
+  fclose(file);
+  return ok;
+}
+
+// Lay the route out as a chain of small steps, each with its pose and wheel travel.
+static std::vector<Node> layOut(const Route& route, const Geometry& geometry) {
+  const std::vector<Waypoint>& p = route.points;
+  size_t last = p.size() - 1;
+  std::vector<Node> nodes;
+
+  for(size_t i = 0; i < last; i++) {
+    // Catmull-Rom tangents, one-sided at the ends.
+    const Waypoint& before = p[i == 0 ? 0 : i - 1];
+    const Waypoint& after = p[i + 1 == last ? last : i + 2];
+    double scale0 = i == 0 ? 1 : 0.5, scale1 = i + 1 == last ? 1 : 0.5;
+    double tx0 = scale0 * (p[i + 1].x - before.x), ty0 = scale0 * (p[i + 1].y - before.y);
+    double tx1 = scale1 * (after.x - p[i].x), ty1 = scale1 * (after.y - p[i].y);
+
+    for(int step = i == 0 ? 0 : 1; step <= STEPS; step++) {
+      double t = (double) step / STEPS;
+      double h00 = 2*t*t*t - 3*t*t + 1, h10 = t*t*t - 2*t*t + t;
+      double h01 = -2*t*t*t + 3*t*t, h11 = t*t*t - t*t;
+      Node node;
+      node.x = h00 * p[i].x + h10 * tx0 + h01 * p[i + 1].x + h11 * tx1;
+      node.y = h00 * p[i].y + h10 * ty0 + h01 * p[i + 1].y + h11 * ty1;
+      node.heading = p[i].heading + t * (p[i + 1].heading - p[i].heading);
+      nodes.push_back(node);
+    }
+  }
+
+  // Travel per metre of wheel distance, from each step to the next.
+  nodes[0].u = 0;
+  for(size_t k = 0; k < nodes.size(); k++) {
+    Node& node = nodes[k];
+    const Node& a = nodes[k + 1 < nodes.size() ? k : k - 1];
+    const Node& b = nodes[k + 1 < nodes.size() ? k + 1 : k];
+    double dx = b.x - a.x, dy = b.y - a.y, dh = b.heading - a.heading;
+    double du = sqrt(dx * dx + dy * dy) + geometry.lever * fabs(dh);
+    if(k + 1 < nodes.size()) nodes[k + 1].u = node.u + du;
+    if(du < 1e-12) du = 1e-12;
+
+    double s = sin(node.heading), c = cos(node.heading);
+    node.forward = (dx * s + dy * c) / du;
+    node.strafe = (dx * c - dy * s) / du;
+    node.turn = dh / du;
+    for(int w = 0; w < 4; w++) {
+      node.wheel[w] = node.forward + geometry.strafeSign[w] * node.strafe
+                    + turnSign[w] * geometry.lever * node.turn;
+    }
+  }
+  return nodes;
+}
+
+/*
+ * Fastest each step may be taken at, then a pass forwards and one backwards so that
+ * neither speeding up nor slowing down ever needs more than the acceleration allowed.
+ */
+static void planSpeed(std::vector<Node>& nodes, const Route& route) {
+  size_t n = nodes.size();
+  for(size_t k = 0; k < n; k++) {
+    Node& node = nodes[k];
+    double fastest = 0;
+    for(double wheel : node.wheel) fastest = fmax(fastest, fabs(wheel));
+    node.speed = fastest > 0 ? route.speed / fastest : route.speed;
+
+    // Cornering: the direction of travel turning by `bend` over `ds` of path.
+    if(k > 0 && k + 1 < n) {
+      double ax = node.x - nodes[k - 1].x, ay = node.y - nodes[k - 1].y;
+      double bx = nodes[k + 1].x - node.x, by = nodes[k + 1].y - node.y;
+      double ds = 0.5 * (hypot(ax, ay) + hypot(bx, by));
+      double du = 0.5 * (nodes[k + 1].u - nodes[k - 1].u);
+      if(ds > 1e-9 && hypot(ax, ay) > 1e-9 && hypot(bx, by) > 1e-9) {
+        double bend = fabs(atan2(ax * by - ay * bx, ax * bx + ay * by));
+        double curvature = bend / ds;
+        if(curvature > 1e-9) node.speed = fmin(node.speed, sqrt(route.accel / curvature) * du / ds);
+      }
+    }
+  }
+  nodes[0].speed = nodes[n - 1].speed = 0;
+
+  for(size_t k = 1; k < n; k++) {
+    double du = nodes[k].u - nodes[k - 1].u;
+    nodes[k].speed = fmin(nodes[k].speed, sqrt(nodes[k - 1].speed * nodes[k - 1].speed + 2 * route.accel * du));
+  }
+  for(size_t k = n - 1; k > 0; k--) {
+    double du = nodes[k].u - nodes[k - 1].u;
+    nodes[k - 1].speed = fmin(nodes[k - 1].speed, sqrt(nodes[k].speed * nodes[k].speed + 2 * route.accel * du));
+  }
+}
+
+// Time and wheel positions at each step.
+static void integrate(std::vector<Node>& nodes, const Geometry& geometry) {
+  Node& first = nodes[0];
+  first.time = 0;
+  for(int w = 0; w < 4; w++) first.position[w] = 0;
+  for(size_t k = 1; k < nodes.size(); k++) {
+    const Node& a = nodes[k - 1];
+    Node& b = nodes[k];
+    double du = b.u - a.u;
+    double speed = 0.5 * (a.speed + b.speed);
+    b.time = a.time + (speed > 0 ? du / speed : 0);
+    for(int w = 0; w < 4; w++) {
+      b.position[w] = a.position[w] + geometry.motorSign[w] * a.wheel[w] * du / (2 * M_PI * geometry.wheelRadius);
+    }
+  }
+}
+
+static bool quantize(double value, double scale, int16_t& out) {
+  double scaled = round(value * scale);
+  if(scaled > 32767 || scaled < -32767) return false;
+  out = (int16_t) scaled;
+  return true;
+}
+
+// The trajectory at `time`, between the two steps either side of it.
+static bool point(const std::vector<Node>& nodes, const Geometry& geometry, double time, TrajectoryPoint& out) {
+  size_t k = 0;
+  while(k + 2 < nodes.size() && nodes[k + 1].time <= time) k++;
+  const Node& a = nodes[k];
+  const Node& b = nodes[k + 1];
+  double f = b.time > a.time ? (time - a.time) / (b.time - a.time) : 1;
+  if(f < 0) f = 0;
+  if(f > 1) f = 1;
+  double speed = a.speed + f * (b.speed - a.speed);
+
+  bool ok = quantize(a.x + f * (b.x - a.x), _TRAJECTORY_H_LENGTH_SCALE, out.x)
+         && quantize(a.y + f * (b.y - a.y), _TRAJECTORY_H_LENGTH_SCALE, out.y)
+         && quantize(a.heading + f * (b.heading - a.heading), _TRAJECTORY_H_ANGLE_SCALE, out.heading)
+         && quantize(speed * a.forward, _TRAJECTORY_H_LENGTH_SCALE, out.forward)
+         && quantize(speed * a.strafe, _TRAJECTORY_H_LENGTH_SCALE, out.strafe)
+         && quantize(speed * a.turn, _TRAJECTORY_H_ANGLE_SCALE, out.turn);
+  for(int w = 0; w < 4; w++) {
+    double wheelSpeed = geometry.motorSign[w] * speed * a.wheel[w] / geometry.wheelRadius / geometry.freeSpeed * 100;
+    double position = a.position[w] + f * (b.position[w] - a.position[w]);
+    ok = ok && quantize(wheelSpeed, _TRAJECTORY_H_SPEED_SCALE, out.wheelSpeed[w])
+            && quantize(position, _TRAJECTORY_H_POSITION_SCALE, out.wheelPosition[w]);
+  }
+  return ok;
+}
+
+static const char* license =
+  "/*\n"
+  " * Copyright (c) 2019 Brandon Gong\n"
+  " *\n"
+  " * Permission is hereby granted, free of charge, to any person obtaining a copy\n"
+  " * of this software and associated documentation files (the \"Software\"), to deal\n"
+  " * in the Software without restriction, including without limitation the rights\n"
+  " * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell\n"
+  " * copies of the Software, and to permit persons to whom the Software is\n"
+  " * furnished to do so, subject to the following conditions:\n"
+  " *\n"
+  " * The above copyright notice and this permission notice shall be included in\n"
+  " * all copies or substantial portions of the Software.\n"
+  " *\n"
+  " * THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR\n"
+  " * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,\n"
+  " * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE\n"
+  " * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER\n"
+  " * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,\n"
+  " * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN\n"
+  " * THE SOFTWARE.\n"
+  " */\n";
+
+int main(int argc, char** argv) {
+  int period = 50;
+  const char* output = nullptr;
+  int opt;
+  while((opt = getopt(argc, argv, "p:o:")) != -1) {
+    if(opt == 'p') period = atoi(optarg);
+    else if(opt == 'o') output = optarg;
+    else optind = argc + 1;
+  }
+  if(optind != argc - 1 || period <= 0) {
+    fprintf(stderr, "usage: %s [-p period] [-o file] route\n", argv[0]);
+    return 2;
+  }
+  const char* path = argv[optind];
+
+  std::vector<Route> routes;
+  if(!readRoutes(path, routes)) {
+    fprintf(stderr, "couldn't read %s\n", path);
+    return 2;
+  }
+
+  sim::World world;
+  world.makeCurrent();
+  Geometry geometry;
+  geometry.wheelRadius = world.chassis.wheelRadius;
+  geometry.lever = world.chassis.halfTrack + world.chassis.halfBase;
+  geometry.freeSpeed = world.motor(FRONT_LEFT_MOTOR_PORT).maxSpeed();
+  for(int w = 0; w < 4; w++) {
+    geometry.strafeSign[w] = world.chassis.strafeSign[w];
+    geometry.motorSign[w] = world.chassis.motorSign[w];
+  }
+
+  FILE* out = output == nullptr ? stdout : fopen(output, "w");
+  if(out == nullptr) {
+    fprintf(stderr, "couldn't write %s\n", output);
+    return 2;
+  }
+  const char* base = strrchr(path, '/');
+  fprintf(out, "%s\n"
+               "/**\n"
+               " * Trajectories for `TrajectoryCommand`, as constant tables.\n"
+               " *\n"
+               " * Generated by host/tools/trajectory from %s; change the route and\n"
+               " * regenerate this file rather than editing it by hand.\n"
+               " */\n"
+               "#include \"Trajectory.h\"\n\n"
+               "#ifndef _TRAJECTORIES_H_\n"
+               "#define _TRAJECTORIES_H_\n",
+          license, base == nullptr ? path : base + 1);
+
+  for(const Route& route : routes) {
+    if(route.points.size() < 2) {
+      fprintf(stderr, "%s: needs at least two points\n", route.name);
+      return 1;
+    }
+    std::vector<Node> nodes = layOut(route, geometry);
+    planSpeed(nodes, route);
+    integrate(nodes, geometry);
+
+    double duration = nodes.back().time * 1000;
+    int count = (int) ceil(duration / period) + 1;
+    fprintf(out, "\n// %s: %.2fm of wheel travel in %.2fs\n", route.name, nodes.back().u, duration / 1000);
+    fprintf(out, "static constexpr TrajectoryPoint %s_POINTS[] = {\n", route.name);
+    for(int i = 0; i < count; i++) {
+      TrajectoryPoint p = TrajectoryPoint();
+      if(!point(nodes, geometry, i * period / 1000.0, p)) {
+        fprintf(stderr, "%s: out of range of the table at %dms\n", route.name, i * period);
+        return 1;
+      }
+      fprintf(out, "  { %6d, %6d, %6d, %6d, %6d, %6d, { %6d, %6d, %6d, %6d }, { %6d, %6d, %6d, %6d } },\n",
+              p.x, p.y, p.heading, p.forward, p.strafe, p.turn,
+              p.wheelSpeed[0], p.wheelSpeed[1], p.wheelSpeed[2], p.wheelSpeed[3],
+              p.wheelPosition[0], p.wheelPosition[1], p.wheelPosition[2], p.wheelPosition[3]);
+    }
+    fprintf(out, "};\n");
+    fprintf(out, "static constexpr Trajectory %s = { %s_POINTS, %d, %d };\n", route.name, route.name, count, period);
+    fprintf(stderr, "%-12s %5.2fs  %4d points  %6d bytes\n",
+            route.name, duration / 1000, count, (int) (count * sizeof(TrajectoryPoint)));
+  }
+
+  fprintf(out, "\n#endif\n");
+  if(out != stdout) fclose(out);
+  return 0;
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "vex.h"
+#include "commands/Command.h"
+#include "subsystems/MecanumDriveTank.h"
+#include "subsystems/RD4BLift.h"
+#include "subsystems/RollerIntake.h"
+
+#ifndef _AUTONOMOUS_H_
+#define _AUTONOMOUS_H_
+
+/**
+ * Builds the autonomous routine as a single command, ready to be handed to the
+ * `Scheduler`.  Drive, lift and intake actions are overlapped wherever they don't
+ * depend on each other, and each step ends on its own sensor condition rather than
+ * on a fixed `task::sleep()`.
+ *
+ * All of the commands come from pools sized for exactly one copy of the routine, so
+ * this must not be called again until the previous routine has finished or been
+ * cancelled.  Returns nullptr if the pools are exhausted or the routine could not be
+ * built, e.g. because two of its parallel commands require the same subsystem.
+ */
+Command* buildAutonomous(MecanumDriveTank* drive, RD4BLift* lift, RollerIntake* intake);
+
+#endif
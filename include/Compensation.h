@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Tuned.h"
+#include "vex.h"
+#include <atomic>
+
+#ifndef _COMPENSATION_H_
+#define _COMPENSATION_H_
+
+// Battery voltage, in volts, that full power is pinned to.  While the battery is above
+// it, outputs are scaled down to what they would be at this voltage; below it, they
+// are scaled up as far as the motors allow.  A little under what a part-used battery
+// holds under load, so that the robot behaves the same for nearly the whole match.
+#ifndef _COMPENSATION_H_REFERENCE
+#define _COMPENSATION_H_REFERENCE 11.5
+#endif
+
+// The voltage the motors take as full power.
+#define _COMPENSATION_H_FULL_SCALE 12.0
+
+// Limits on the compensation factor, in case of a bad or missing reading.
+#define _COMPENSATION_H_MIN_FACTOR 0.8
+#define _COMPENSATION_H_MAX_FACTOR 1.25
+
+/**
+ * Battery voltage compensation for open-loop motor outputs.  Velocity commands don't
+ * need it: the motor's own velocity loop already makes up for a flat battery.
+ *
+ * A voltage command to a V5 motor is really a duty cycle: asking for 6V gets half of
+ * whatever the battery has.  So the same command pushes noticeably harder on a fresh
+ * battery than a flat one.  This scales every open-loop command by
+ * _COMPENSATION_H_REFERENCE over the filtered battery voltage, so that a given
+ * percentage means the same actual voltage at the motor at any charge.
+ *
+ * The battery voltage comes from the sensing task, which already samples it at a low
+ * rate and filters out the sag from each change in motor current.  The factor is a
+ * single atomic, so the control loop can read it every tick without locking.
+ */
+class Compensation {
+
+  public:
+
+    Compensation();
+
+    // Work out the factor for a new filtered battery reading, in volts.
+    void setBatteryVoltage(double volts);
+
+    // Returns the current compensation factor; 1 until there has been a reading.
+    double getFactor() const;
+
+    // Returns the voltage to command for `percent` (-100...100) of full power.
+    double toVolts(double percent) const;
+
+    // Spin `m` at `volts` as they would be at the reference voltage, compensated.
+    void spinVolts(motor& m, double volts) const;
+
+  private:
+
+    std::atomic<float> factor;
+};
+
+/**
+ * The compensation used by every subsystem, fed by the sensing task.
+ */
+extern Compensation batteryCompensation;
+
+#endif
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "vex.h"
+#include "Feedforward.h"
+
+#ifndef _CONFIG_H_
+#define _CONFIG_H_
+
+// The file on the SD card that holds the runtime configuration.
+#define _CONFIG_H_FILE "config.txt"
+
+// Largest configuration file that will be read, in bytes.
+#define _CONFIG_H_MAX_SIZE 2048
+
+// Number of lift heights the drive limits are worked out for, spread evenly from the
+// floor to `liftTipHeight`.
+#define _CONFIG_H_DRIVE_STEPS 16
+
+/**
+ * How hard the drive base may be driven at one lift height.
+ */
+struct DriveLimit {
+  int32_t accel;   // Largest change in wheel power per tick, in percent
+  int32_t speed;   // Largest wheel power, in percent
+};
+
+/**
+ * All of the tuning constants used by the subsystems, in one flat struct.
+ *
+ * The compiled-in defaults are the preprocessor definitions in each subsystem's header
+ * (e.g. _MDT_H_DEADBAND), which may in turn be overridden by the generated `Tuned.h`.
+ * Subsystems read these through a pointer set once at construction, so changing a
+ * value never costs more than a memory read in the hot loop, and tools can give each
+ * subsystem its own copy.
+ *
+ * Any of the values can also be changed without a rebuild by putting a file on the
+ * SD card with one `name = value` line per field, using the field names below (e.g.
+ * `liftPresetSpeed = 60`).  Blank lines and lines starting with `#` are skipped, and
+ * fields that aren't mentioned keep their compiled-in default.  So do fields whose value
+ * is out of range or not a number; those, and names that aren't fields, are printed on
+ * the terminal.
+ */
+struct Config {
+
+  // Deadbands, in percent of stick travel.
+  int32_t driveDeadband;    // MecanumDriveTank
+  int32_t arcadeDeadband;   // MecanumDriveArcade
+  int32_t liftDeadband;     // RD4BLift
+
+  // RD4BLift preset heights and tolerance, in revolutions of the left lift motor.
+  double liftFloor;
+  double liftLowerTower;
+  double liftUpperTower;
+  double liftTolerance;
+
+  // Top of the RD4BLift's travel, in revolutions of the left lift motor, and how hard
+  // it may be slowed down coming up to either end, in percent per second.
+  double liftMaxHeight;
+  double liftStopDecel;
+
+  // Speed the RD4BLift moves between presets at, in percent.
+  int32_t liftPresetSpeed;
+
+  // RollerIntake power, in percent.
+  int32_t rollerPower;
+
+  // MecanumDriveTank limits with the lift raised, to keep the robot from tipping.  Up
+  // to `liftSafeHeight` the drive is unlimited; from there they tighten linearly until
+  // `liftTipHeight`, above which the drive is held to `tipAccel` and `tipSpeed`.
+  // Heights are in revolutions of the left lift motor, like the presets.
+  double liftSafeHeight;
+  double liftTipHeight;
+  int32_t tipAccel;
+  int32_t tipSpeed;
+
+  // Extra wheel speed the MecanumDriveTank adds while following a trajectory, in
+  // percent per revolution the wheel is behind.
+  double followGain;
+
+  // MecanumDriveTank traction control: the slip ratio above which a wheel counts as
+  // slipping, and the fastest a wheel's ground speed can change, in percent per second.
+  double tractionSlip;
+  double tractionAccel;
+
+  // Feedforward models, used by subsystems that have had `useFeedforward()` turned on.
+  // In the file, the gains are named like `driveModel.kV`.
+  Feedforward driveModel;
+  Feedforward liftModel;
+  Feedforward rollerModel;
+
+  // The limits above worked out for each of _CONFIG_H_DRIVE_STEPS heights, so that the
+  // drive only needs a table lookup each tick.  Derived; not read from the file.
+  DriveLimit driveLimits[_CONFIG_H_DRIVE_STEPS];
+
+  // Fills every field with its compiled-in default.
+  Config();
+
+  /**
+   * Replaces every field with the contents of `name` on the SD card, or the compiled-in
+   * default for fields the file doesn't mention.  Returns the number of fields read
+   * from the file, or -1 (leaving everything untouched) if there is no card or no file.
+   *
+   * Only call this between subsystem updates; it is far too slow for the control loop.
+   */
+  int32_t load(const char* name = _CONFIG_H_FILE);
+
+  // Returns the drive limits for the given lift height, in revolutions.
+  const DriveLimit& driveLimit(double height) const;
+
+  // Fills in `driveLimits` from the fields above it.  Done by the constructor and
+  // `load()`; anything else that changes those fields has to call it too.
+  void buildDriveLimits();
+};
+
+/**
+ * The configuration used by every subsystem on the robot unless told otherwise.
+ */
+extern Config activeConfig;
+
+#endif
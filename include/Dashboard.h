@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "vex.h"
+#include "RobotState.h"
+
+#ifndef _DASHBOARD_H_
+#define _DASHBOARD_H_
+
+// Time between frames, in milliseconds.  Caps the dashboard at 10 frames per second.
+#define _DASHBOARD_H_FRAME_TIME 100
+
+// Stall time, in milliseconds, over which a motor is shown in red after the match.
+#define _DASHBOARD_H_STALL_WARNING 2000
+
+/**
+ * Shows what the robot is doing on the Brain screen: the lift's State, the battery,
+ * how long the control loop takes, and the temperature of every motor.
+ *
+ * `start()` runs the dashboard in its own low-priority task at a capped frame rate.
+ * Everything shown comes from `controlState` and `sensorState`, so drawing never
+ * touches the subsystems or the hardware.  Every value is drawn in its own
+ * fixed-width widget, and a widget is only drawn again when its (rounded) value
+ * changes, so a frame where nothing changed costs a handful of reads and no drawing at
+ * all.  Drawing pauses while the watchdog has extras turned off.
+ *
+ * Once the robot is disabled after a match, the screen switches to a table of the
+ * `motorStats` for the match, with any motor that ran hot or stalled in red, and
+ * switches back when the robot is enabled again.
+ */
+class Dashboard {
+
+  public:
+
+    Dashboard();
+
+    // Start drawing in a low-priority task.
+    void start();
+
+    /**
+     * Draws one frame, redrawing only the widgets whose value changed.  Returns the
+     * number of widgets that were redrawn.
+     */
+    int32_t draw();
+
+  private:
+
+    /**
+     * One value on the screen, drawn at a fixed position and width.
+     */
+    struct Widget {
+      int32_t x;
+      int32_t y;
+      int32_t width;    // in characters, so shorter text still covers longer text
+      int32_t shown;    // value currently on screen
+      bool drawn;
+    };
+
+    // Draw `widget` if `value` differs from what is on screen.  Returns whether it did.
+    bool show(Widget& widget, int32_t value, const char* format, ...);
+
+    // Draw the motor statistics page in one go.
+    void drawStats(const MotorStats& stats);
+
+    // Entry point of the dashboard task.
+    static int run(void* dashboard);
+
+    vex::brain brain;
+
+    Widget liftWidget;
+    Widget batteryWidget;
+    Widget loopWidget;
+    Widget motorWidgets[_ROBOTSTATE_H_MOTORS];
+
+    bool cleared;
+    bool statsShown;
+};
+
+#endif
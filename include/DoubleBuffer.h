@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <atomic>
+#include <stdint.h>
+
+#ifndef _DOUBLEBUFFER_H_
+#define _DOUBLEBUFFER_H_
+
+/**
+ * Passes a value of type `T` from one writer task to any number of reader tasks
+ * without a lock, so a slow low-priority reader can never hold up the writer.
+ *
+ * The writer always fills the copy readers aren't being pointed at and then flips a
+ * sequence number to publish it.  A reader copies the published value and checks the
+ * sequence number didn't move while it was copying; if it did, the writer may have
+ * started on that copy, so the reader simply tries again.  The writer never waits.
+ *
+ * `T` should be a plain struct; it is copied on every read and write.
+ *
+ * Usage:
+ *
+ *    DoubleBuffer<ControlState> state;
+ *    state.write(current);       // writer task
+ *    ControlState latest;
+ *    state.read(latest);         // any other task
+ */
+template <typename T>
+class DoubleBuffer {
+
+  public:
+
+    DoubleBuffer() : sequence(0) {}
+
+    // Publish a new value.  Only ever call this from one task.
+    void write(const T& value) {
+      uint32_t next = this->sequence.load(std::memory_order_relaxed) + 1;
+      this->buffers[next & 1] = value;
+      this->sequence.store(next, std::memory_order_release);
+    }
+
+    /**
+     * Copy the latest value into `value`.  Returns false (leaving `value` untouched) if
+     * nothing has been written yet.
+     */
+    bool read(T& value) const {
+      while(true) {
+        uint32_t current = this->sequence.load(std::memory_order_acquire);
+        if(current == 0) return false;
+        value = this->buffers[current & 1];
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if(this->sequence.load(std::memory_order_relaxed) == current) return true;
+      }
+    }
+
+    // Number of values written so far; changes whenever a new value is published.
+    uint32_t version() const {
+      return this->sequence.load(std::memory_order_acquire);
+    }
+
+  private:
+
+    T buffers[2];
+    std::atomic<uint32_t> sequence;
+};
+
+#endif
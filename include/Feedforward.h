@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#ifndef _FEEDFORWARD_H_
+#define _FEEDFORWARD_H_
+
+/**
+ * A feedforward model of one mechanism: the voltage it takes to move at a velocity
+ * while accelerating at a rate,
+ *
+ *    volts = kS * sign(v) + kV * v + kA * a + kG
+ *
+ * where kS overcomes friction, kV holds a speed against back-EMF, kA accelerates the
+ * mechanism's inertia, and kG holds up a load against gravity (zero for anything that
+ * doesn't lift).  Velocities are in percent of the motor's free speed and
+ * accelerations in percent per second, so the same gains work whatever cartridge is
+ * fitted.  The voltages are at the compensation reference voltage; see
+ * `Compensation`.
+ */
+struct Feedforward {
+  double kS;    // volts
+  double kV;    // volts per percent
+  double kA;    // volts per percent per second
+  double kG;    // volts
+
+  // Returns the voltage for `velocity` (percent) and `acceleration` (percent per second).
+  double volts(double velocity, double acceleration) const {
+    double friction = velocity > 0 ? this->kS : velocity < 0 ? -this->kS : 0;
+    return friction + this->kV * velocity + this->kA * acceleration + this->kG;
+  }
+};
+
+#endif
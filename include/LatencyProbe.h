@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "vex.h"
+#include "subsystems/Subsystem.h"
+#include <atomic>
+
+#ifndef _LATENCYPROBE_H_
+#define _LATENCYPROBE_H_
+
+// Number of samples kept, per stage.
+#define _LATENCYPROBE_H_SAMPLES 128
+
+// A change in the input of at least this much (percent) starts a sample.
+#define _LATENCYPROBE_H_INPUT_STEP 20
+
+// The motor has responded once its velocity has moved this much (percent).
+#define _LATENCYPROBE_H_RESPONSE 5
+
+// Samples where the motor hasn't responded after this long (milliseconds) are dropped,
+// e.g. when the input only moved within the deadband.
+#define _LATENCYPROBE_H_TIMEOUT 500
+
+// Time between polls of the input and the motor, in milliseconds.
+#define _LATENCYPROBE_H_POLL_TIME 1
+
+/**
+ * Follows a change of one controller axis through the control loop to the motor it
+ * drives, and measures how long each stage takes:
+ *  - INPUT_TO_SNAPSHOT: from the brain first seeing the new stick position to the
+ *    start of the tick that reads it, i.e. time spent waiting out `wait()`;
+ *  - SNAPSHOT_TO_COMMAND: from the start of that tick to the end of it, by which time
+ *    the subsystem has polled its inputs and set the motor;
+ *  - COMMAND_TO_RESPONSE: from then until the motor's measured velocity moves;
+ *  - TOTAL: all of the above.
+ *
+ * `poll()` watches the input and the motor and must be called every
+ * _LATENCYPROBE_H_POLL_TIME; `start()` does that from a high-priority task.  The
+ * control loop calls `tickStarted()` and `tickEnded()` around each tick.  Only one
+ * change is followed at a time.
+ *
+ * Time before the brain sees the stick move (the radio link) can't be measured here.
+ */
+class LatencyProbe {
+
+  public:
+
+    enum Stage {
+      INPUT_TO_SNAPSHOT,
+      SNAPSHOT_TO_COMMAND,
+      COMMAND_TO_RESPONSE,
+      TOTAL,
+      STAGE_COUNT
+    };
+
+    /**
+     * Creates a new instance of `LatencyProbe`.
+     *
+     * @param
+     *    input - the axis to watch, read the same way the subsystem reads it.
+     *    motorPort - the port of a motor that the axis drives.
+     */
+    LatencyProbe(Subsystem::AxisInput input, int32_t motorPort);
+
+    // Poll from a high-priority task until the program ends.
+    void start();
+
+    // Check the input and the motor once.
+    void poll();
+
+    // Call with the time (in microseconds) each tick of the control loop starts and ends.
+    void tickStarted(uint64_t time);
+    void tickEnded(uint64_t time);
+
+    // Number of complete samples so far.
+    uint32_t getSampleCount();
+
+    /**
+     * Percentile `percent` (0...100) of the kept samples for `stage`, in microseconds.
+     */
+    uint32_t getPercentile(Stage stage, int32_t percent);
+
+    // Print the distribution of each stage to the terminal.
+    void report();
+
+  private:
+
+    enum Phase {
+      IDLE,             // waiting for the input to change
+      WAITING_FOR_TICK, // input changed, loop hasn't started a tick since
+      IN_TICK,          // the tick that reads it is running
+      WAITING_FOR_MOTOR // motor has been commanded, waiting for it to move
+    };
+
+    // Entry point of the polling task.
+    static int run(void* probe);
+
+    Subsystem::AxisInput input;
+    motor& probed;
+
+    // Moved on by both the probe task and the control task, so each move checks that
+    // the other side hasn't moved it first.
+    std::atomic<Phase> phase;
+    int32_t lastInput;
+    double baseline;
+    // When the input changed, its tick started and ended, and the motor moved.
+    uint64_t inputTime, snapshotTime, commandTime;
+
+    uint32_t samples[STAGE_COUNT][_LATENCYPROBE_H_SAMPLES];
+    uint32_t sampleCount;
+};
+
+#endif
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "vex.h"
+#include "RobotState.h"
+
+#ifndef _LOGGER_H_
+#define _LOGGER_H_
+
+// The file on the SD card that the log is appended to.
+#define _LOGGER_H_FILE "log.csv"
+
+// The file on the SD card that a summary of the motor statistics is appended to after
+// every match.
+#define _LOGGER_H_SUMMARY_FILE "motors.csv"
+
+// Time between log lines, in milliseconds.
+#define _LOGGER_H_PERIOD 100
+
+// Lines are collected here and written to the card in one go, since every write to the
+// card is slow no matter how small.
+#define _LOGGER_H_BUFFER 4096
+
+// Longest a line may sit in the buffer before being written, in milliseconds.
+#define _LOGGER_H_FLUSH_TIME 2000
+
+/**
+ * Writes `controlState` and `sensorState` to a CSV file on the SD card from a
+ * low-priority task, while the robot is enabled.  Every run appends to the same file,
+ * which gets its header when it is first created.  Logging is optional work: it pauses
+ * whenever the watchdog says extras are off, and does nothing without an SD card.
+ *
+ * When the robot is disabled, the logger also appends one line to a second file
+ * with the `motorStats` for the match: per motor, the mean, largest and standard
+ * deviation of the current, the highest temperature, and the seconds spent at high
+ * current, hot and stalled.
+ */
+class Logger {
+
+  public:
+
+    Logger();
+
+    // Log from a low-priority task until the program ends.
+    void start();
+
+    // Add one line to the log, and write the buffer out if it is due.
+    void update();
+
+    // Write whatever is in the buffer to the card.
+    void flush();
+
+    // Write the motor statistics to the card as one line.
+    void writeSummary(const MotorStats& stats);
+
+  private:
+
+    // Entry point of the logging task.
+    static int run(void* logger);
+
+    // Add printf-style text to the buffer.
+    void append(const char* format, ...);
+
+    vex::brain brain;
+    char buffer[_LOGGER_H_BUFFER];
+    int32_t length;
+    uint32_t lastFlush;
+    bool started;
+
+    // Whether the last finished set of motor statistics has been written.
+    bool summarized;
+};
+
+#endif
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "vex.h"
+
+#ifndef _MESSAGEQUEUE_H_
+#define _MESSAGEQUEUE_H_
+
+// Lines on the controller screen, and the characters that fit on each.
+#define _MESSAGEQUEUE_H_LINES 3
+#define _MESSAGEQUEUE_H_WIDTH 19
+
+// Time between writes to the controller, in milliseconds.  Writes any closer together
+// than this get dropped by the radio link.
+#define _MESSAGEQUEUE_H_SEND_TIME 60
+
+// Messages that have waited longer than this (in milliseconds) are no longer worth showing.
+#define _MESSAGEQUEUE_H_MAX_AGE 1000
+
+/**
+ * Status text and rumble patterns for the driver, sent to the controller from a
+ * background task so that the control loop never waits on the radio link.
+ *
+ * Each screen line holds at most one pending message: posting to a line replaces
+ * whatever was waiting there, and posting what is already on screen does nothing.
+ * The task sends one pending item every _MESSAGEQUEUE_H_SEND_TIME, rumbles first and
+ * then the oldest line, and drops anything older than _MESSAGEQUEUE_H_MAX_AGE.
+ *
+ * `post()` and `rumble()` never wait on the radio link.  They share a lock with the
+ * task, but the task only holds it to copy out the next item, so at worst they wait
+ * for a few string copies.  A message is never lost to the task being busy, which
+ * matters for one-off notices like "Intake jammed".
+ *
+ * Lines are shared out as follows: 1 for the lift, 2 for the intake, 3 for the robot.
+ */
+class MessageQueue {
+
+  public:
+
+    MessageQueue();
+
+    /**
+     * Show a printf-style message on one line of the controller screen.
+     *
+     * @param
+     *    line - 1..._MESSAGEQUEUE_H_LINES
+     *    format - text, cut off at _MESSAGEQUEUE_H_WIDTH characters
+     */
+    void post(int32_t line, const char* format, ...);
+
+    /**
+     * Rumble the controller.  Replaces any rumble that hasn't been sent yet.
+     *
+     * @param
+     *    pattern - dots and dashes, as for `vex::controller::rumble()`.  Must be a string
+     *              literal, since only the pointer is kept.
+     */
+    void rumble(const char* pattern);
+
+    // Start sending to `controller` from a low-priority task.
+    void start(vex::controller* controller);
+
+    /**
+     * Send at most one pending item to `controller`, dropping stale ones on the way.
+     * Returns whether anything was sent.  This is what the task calls; it can take as
+     * long as the radio link does, so never call it from the control loop.
+     */
+    bool send(vex::controller* controller);
+
+  private:
+
+    struct Line {
+      char text[_MESSAGEQUEUE_H_WIDTH + 1];     // waiting to be sent
+      char shown[_MESSAGEQUEUE_H_WIDTH + 1];    // on the screen now
+      uint32_t posted;
+      bool pending;
+    };
+
+    // Entry point of the sending task.
+    static int run(void* queue);
+
+    Line lines[_MESSAGEQUEUE_H_LINES];
+    const char* rumblePattern;
+    uint32_t rumblePosted;
+
+    vex::controller* controller;
+    vex::mutex lock;
+};
+
+/**
+ * The queue for the primary controller, used by every subsystem.
+ */
+extern MessageQueue controllerMessages;
+
+#endif
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "vex.h"
+
+#ifndef _MOTORSTATS_H_
+#define _MOTORSTATS_H_
+
+// Number of motors the statistics are kept for; the same as _ROBOTSTATE_H_MOTORS.
+#define _MOTORSTATS_H_MOTORS 8
+
+// Current, in amps, above which a motor counts as working hard.  The V5 limits each
+// motor to 2.5A.
+#define _MOTORSTATS_H_HIGH_CURRENT 2.0
+
+// Temperature, in celsius, at which the motor firmware starts cutting the current.
+#define _MOTORSTATS_H_HOT 55
+
+// A motor is stalled when it draws over _MOTORSTATS_H_STALL_CURRENT amps but turns
+// slower than _MOTORSTATS_H_STALL_SPEED percent.
+#define _MOTORSTATS_H_STALL_CURRENT 1.5
+#define _MOTORSTATS_H_STALL_SPEED 5
+
+// How long the robot has to sit disabled, in milliseconds, before being enabled again
+// starts a new set of statistics.  Longer than the pause between autonomous and
+// driver control, so that one match is one set.
+#define _MOTORSTATS_H_MATCH_GAP 60000
+
+/**
+ * Minimum, maximum, mean and variance of a stream of values, updated one value at a
+ * time with Welford's method, so it takes constant memory and a few operations per
+ * value, and doesn't lose precision over a long run the way summing squares does.
+ */
+struct RunningStat {
+  uint32_t count;
+  double min, max, mean;
+  double m2;          // sum of squared differences from the mean
+
+  void reset();
+  void add(double value);
+  double variance() const;
+};
+
+/**
+ * Statistics for one motor.  Times are in milliseconds.
+ */
+struct MotorStat {
+  RunningStat current;        // amps
+  RunningStat temperature;    // celsius
+  uint32_t highCurrentTime;   // above _MOTORSTATS_H_HIGH_CURRENT
+  uint32_t hotTime;           // at or above _MOTORSTATS_H_HOT
+  uint32_t stallTime;
+};
+
+/**
+ * Running statistics for every motor on the robot over a match, in the order of
+ * `motorPorts`.  The sensing task adds every sample it takes while the robot is
+ * enabled, and publishes the result as `motorStats` for the dashboard, which shows it
+ * after the match, and the logger, which writes it to the SD card as one record.
+ */
+struct MotorStats {
+  uint32_t time;              // milliseconds of enabled time covered
+  bool running;               // false once the robot has been disabled
+  MotorStat motors[_MOTORSTATS_H_MOTORS];
+
+  void reset();
+
+  /**
+   * Add one sample of every motor, covering `dt` milliseconds.
+   *
+   * @param
+   *    current, temperature, velocity - One reading per motor, in amps, celsius
+   *                                     and percent.
+   */
+  void add(const double* current, const double* temperature, const double* velocity, uint32_t dt);
+};
+
+#endif
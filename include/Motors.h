@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "vex.h"
+
+#ifndef _MOTORS_H_
+#define _MOTORS_H_
+
+// Number of smart ports on the brain (PORT1 to PORT21).
+#define _MOTORS_H_PORTS 21
+
+/**
+ * Owns the one `vex::motor` handle for every port.
+ *
+ * A `vex::motor` keeps some state of its own on the brain side, such as the brake mode
+ * `stop()` uses, so two handles on the same port can disagree about what that motor
+ * should be doing.  Everything that drives or reads a motor (the subsystems, the
+ * latency probe, the sensing task) takes its handle from here rather than building
+ * its own, so there is only ever one per port.  The ports in `RobotMap.h` are checked
+ * for conflicts when this compiles.
+ *
+ * The handles are built the first time any of them is asked for, which is when the
+ * subsystems are constructed, before any task is started.
+ */
+class Motors {
+
+  public:
+
+    // The handle for `port` (0-based, as with the PORTn constants).  Stops the program if
+    // `port` is out of range.
+    static motor& get(int32_t port);
+
+    /**
+     * Read the temperature (degrees C), current (A) and velocity (percent) of every
+     * motor in `motorPorts`, in that order, in one pass.
+     */
+    static void sample(double temperature[], double current[], double velocity[]);
+
+  private:
+
+    // Every handle, indexed by port.
+    static motor* handles();
+};
+
+#endif
@@ -45,4 +45,10 @@ using namespace vex;
 #define ROLLER_LEFT_MOTOR_PORT PORT8
 #define ROLLER_RIGHT_MOTOR_PORT PORT2
 
+// Every motor port above, in the order of `motorPorts`.  `Motors` checks these for
+// conflicts when it compiles.
+#define MOTOR_PORTS FRONT_LEFT_MOTOR_PORT, FRONT_RIGHT_MOTOR_PORT, BACK_LEFT_MOTOR_PORT, \
+                    BACK_RIGHT_MOTOR_PORT, LIFT_LEFT_MOTOR_PORT, LIFT_RIGHT_MOTOR_PORT, \
+                    ROLLER_LEFT_MOTOR_PORT, ROLLER_RIGHT_MOTOR_PORT
+
 #endif
\ No newline at end of file
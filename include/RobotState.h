@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "vex.h"
+#include "DoubleBuffer.h"
+#include "MotorStats.h"
+#include "subsystems/RD4BLift.h"
+#include "Watchdog.h"
+
+#ifndef _ROBOTSTATE_H_
+#define _ROBOTSTATE_H_
+
+// Number of motors on the robot, in the order of `motorPorts`.
+#define _ROBOTSTATE_H_MOTORS 8
+
+static_assert(_MOTORSTATS_H_MOTORS == _ROBOTSTATE_H_MOTORS, "MotorStats must cover every motor");
+
+/**
+ * The ports of every motor on the robot, and short names for them, in a fixed order
+ * that every per-motor array below follows.
+ */
+extern const int32_t motorPorts[_ROBOTSTATE_H_MOTORS];
+extern const char* motorNames[_ROBOTSTATE_H_MOTORS];
+
+/**
+ * What the control task publishes at the end of every tick.
+ */
+struct ControlState {
+  uint32_t time;                  // milliseconds since the program started
+  uint32_t ticks;
+  bool enabled;                   // driver control or autonomous is running
+  RD4BLift::State liftState;
+  double liftHeight;              // revolutions of the left lift motor
+  double driveDistance;           // revolutions, as for MecanumDriveTank::getDistance()
+  double wheelSlip[4];            // slip ratios, as for MecanumDriveTank::getSlip()
+  bool intakeJammed;
+  uint32_t busy;                  // microseconds the tick took
+  uint32_t period;                // microseconds since the tick before it started
+  Watchdog::Level watchdogLevel;
+  uint32_t overruns;
+  int32_t overrunBy;              // offender of the latest overrun, as in Watchdog::Overrun
+};
+
+/**
+ * What the sensing task publishes every time it samples the robot.
+ */
+struct SensorState {
+  uint32_t time;                  // milliseconds since the program started
+  double batteryVoltage;          // filtered
+  double compensation;            // factor applied to open-loop motor outputs
+  double batteryCurrent;
+  int32_t batteryCapacity;        // percent
+  double motorTemperature[_ROBOTSTATE_H_MOTORS];  // celsius
+  double motorCurrent[_ROBOTSTATE_H_MOTORS];      // amps
+  double motorVelocity[_ROBOTSTATE_H_MOTORS];     // percent
+};
+
+/**
+ * The only way data moves between the tasks: each is written by exactly one task and
+ * read by any of the others without locking.  See `DoubleBuffer`.
+ */
+extern DoubleBuffer<ControlState> controlState;   // written by the control task
+extern DoubleBuffer<SensorState> sensorState;     // written by the sensing task
+extern DoubleBuffer<MotorStats> motorStats;       // written by the sensing task
+
+#endif
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "vex.h"
+#include "RobotState.h"
+
+#ifndef _SENSING_H_
+#define _SENSING_H_
+
+// Time between samples, in milliseconds.
+#define _SENSING_H_PERIOD 10
+
+// Weight of each new battery reading in the filtered voltage.  The raw reading jumps
+// around with every change in motor current.
+#define _SENSING_H_BATTERY_FILTER 0.05
+
+// Samples between publishing the motor statistics.
+#define _SENSING_H_STATS_EVERY 10
+
+/**
+ * Samples the battery and every motor at a steady rate from a medium-priority task,
+ * filters what needs filtering, and publishes the result as `sensorState`.  The
+ * filtered battery voltage also sets `batteryCompensation`.  While the robot is
+ * enabled, every sample also goes into the running `MotorStats`, published as
+ * `motorStats`.
+ *
+ * Anything that wants sensor readings but isn't part of the control loop itself (the
+ * dashboard, logging, estimates built on top of the readings) should read them from
+ * `sensorState` rather than going to the hardware again.
+ */
+class Sensing {
+
+  public:
+
+    Sensing();
+
+    // Sample from a medium-priority task until the program ends.
+    void start();
+
+    // Take one sample and publish it.
+    void update();
+
+  private:
+
+    // Entry point of the sensing task.
+    static int run(void* sensing);
+
+    // Add the latest sample to the motor statistics while the robot is enabled, and
+    // publish them now and then.
+    void updateStats();
+
+    vex::brain brain;
+    SensorState state;
+    bool sampled;
+
+    MotorStats stats;
+    bool enabled;
+    uint32_t lastSample, disabledSince;
+    int32_t unpublished;
+};
+
+#endif
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Tuned.h"
+#include "vex.h"
+#include <atomic>
+#include <functional>
+
+#ifndef _STARTUP_H_
+#define _STARTUP_H_
+
+// Most setup steps the robot can run at once.
+#define _STARTUP_H_STEPS 8
+
+// How long the control loop waits for setup before it starts without it, in
+// milliseconds.  Autonomous has to start on time even if a step never finishes.
+#ifndef _STARTUP_H_TIMEOUT
+#define _STARTUP_H_TIMEOUT 3000
+#endif
+
+// Time between checks on the setup steps while waiting for them, in milliseconds.
+#define _STARTUP_H_POLL_TIME 5
+
+/**
+ * Runs the robot's setup steps (loading the configuration, zeroing encoders, setting
+ * brake modes) each in its own task, so that a step waiting on the SD card or on a
+ * device doesn't hold up the rest, and times every step.
+ *
+ * Steps are added with `add()` and all set off together by `start()`.  Steps must not
+ * depend on each other; anything that has to happen in order belongs in one step.  The
+ * control loop calls `wait()` before its first tick, so nothing is commanded until the
+ * robot is ready, and carries on without any step that hasn't finished by the timeout.
+ */
+class Startup {
+
+  public:
+
+    Startup();
+
+    /**
+     * Adds a setup step.  Must be called before `start()`.
+     *
+     * @param name  Short name of the step, shown in the report.  Not copied.
+     * @param step  What to do.
+     * @return      False if there are already _STARTUP_H_STEPS steps.
+     */
+    bool add(const char* name, std::function<void()> step);
+
+    // Start every step, each in its own task.
+    void start();
+
+    // Whether every step has finished.
+    bool isDone() const;
+
+    /**
+     * Waits until every step has finished, or until `timeout` milliseconds after
+     * `start()`, whichever comes first.
+     *
+     * @return Whether every step finished.
+     */
+    bool wait(uint32_t timeout);
+
+    // Name of the first step that hasn't finished yet, or nullptr if they all have.
+    const char* getPending() const;
+
+    // Milliseconds from `start()` until the last step finished, or until now if some
+    // still haven't.
+    uint32_t getElapsed() const;
+
+    // Print how long each step took to the terminal.  Slow, so not from the control task.
+    void report() const;
+
+  private:
+
+    struct Step {
+      const char* name;
+      std::function<void()> run;
+      std::atomic<bool> done;
+      // Set by the step's own task before `done`, in microseconds.
+      uint64_t started, finished;
+    };
+
+    // Entry point of each step's task.
+    static int run(void* step);
+
+    Step steps[_STARTUP_H_STEPS];
+    int32_t count;
+    uint64_t started;
+};
+
+#endif
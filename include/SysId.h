@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "vex.h"
+#include "subsystems/MecanumDriveTank.h"
+#include "subsystems/RD4BLift.h"
+#include <atomic>
+
+#ifndef _SYSID_H_
+#define _SYSID_H_
+
+// Time between samples, in milliseconds.
+#define _SYSID_H_PERIOD 5
+
+// Number of samples kept; 40 seconds of tests at _SYSID_H_PERIOD.
+#define _SYSID_H_SAMPLES 8000
+
+// File on the SD card that `save()` writes to.
+#define _SYSID_H_FILE "sysid.csv"
+
+/**
+ * Records characterization tests of one mechanism (the drive base or the lift), for
+ * fitting its `Feedforward` constants on a computer afterwards with `host/tools/sysid`.
+ *
+ * The test itself is run by `SysIdCommand`, which sets the voltage through `apply()`
+ * once a tick.  Meanwhile `sample()` records the time, the voltage last applied, and
+ * the mechanism's speed and position; `start()` calls it every _SYSID_H_PERIOD from a
+ * high-priority task, so the samples are evenly spaced whatever the control loop is
+ * doing.  Samples only go into RAM while a test runs, and `save()` writes them to the
+ * SD card afterwards, so the card can't hold up either the test or the sampling.
+ *
+ * Voltages are in reference volts (see `Compensation`), the same units the
+ * `Feedforward` model outputs; speeds are in percent and positions in revolutions.
+ */
+class SysId {
+
+  public:
+
+    enum Mechanism {
+      DRIVE,
+      LIFT
+    };
+
+    enum Test {
+      RAMP_FORWARD,   // voltage rising slowly, so acceleration is negligible
+      RAMP_BACKWARD,
+      STEP_FORWARD,   // a fixed voltage from a standstill, to see the acceleration
+      STEP_BACKWARD,
+      TEST_COUNT
+    };
+
+    struct Sample {
+      uint32_t time;  // microseconds since the test began
+      uint8_t test;
+      float volts;
+      float speed;
+      float position;
+    };
+
+    // Creates a new instance of `SysId` that records the drive base.
+    SysId(MecanumDriveTank* drive);
+
+    // Creates a new instance of `SysId` that records the lift.
+    SysId(RD4BLift* lift);
+
+    // Sample from a high-priority task until the program ends.
+    void start();
+
+    // Record one sample, if a test is running.
+    void sample();
+
+    // Start and stop recording `test`.
+    void begin(Test test);
+    void end();
+
+    // Drop every sample recorded so far.  Not while a test is running.
+    void clear();
+
+    // Set `volts` on the mechanism, and record it in the samples from now on.
+    void apply(double volts);
+
+    // Stop the mechanism where it is: braked for the drive base, held for the lift.
+    void stop();
+
+    /**
+     * The voltage that only just holds the mechanism against gravity, which the lift's
+     * tests other than RAMP_FORWARD are run relative to.  RAMP_FORWARD finds it as the
+     * voltage the lift starts to move up at.  Zero for the drive base, and until found.
+     */
+    void setHoldVoltage(double volts);
+    double getHoldVoltage();
+
+    // Speed (percent) and position (revolutions) of the mechanism, positive forwards/up.
+    double getSpeed();
+    double getPosition();
+
+    Mechanism getMechanism();
+    Subsystem* getSubsystem();
+
+    uint32_t getSampleCount();
+    bool isFull();
+    const Sample& getSample(uint32_t index);
+
+    /**
+     * Write every sample to _SYSID_H_FILE on the SD card, as CSV with a comment line
+     * naming the mechanism.  Returns the number of samples written, or -1 if there is
+     * no card.  Slow; call it from a low-priority task once the tests are over.
+     */
+    int32_t save();
+
+  private:
+
+    // Entry point of the sampling task.
+    static int run(void* sysid);
+
+    Mechanism mechanism;
+    MecanumDriveTank* drive;
+    RD4BLift* lift;
+
+    std::atomic<bool> recording;
+    std::atomic<float> volts;
+    double holdVolts;
+    Test test;
+    uint64_t testStart;
+
+    Sample samples[_SYSID_H_SAMPLES];
+    std::atomic<uint32_t> sampleCount;
+
+    vex::brain brain;
+};
+
+#endif
@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * Trajectories for `TrajectoryCommand`, as constant tables.
+ *
+ * Generated by host/tools/trajectory from autonomous.route; change the route and
+ * regenerate this file rather than editing it by hand.
+ */
+#include "Trajectory.h"
+
+#ifndef _TRAJECTORIES_H_
+#define _TRAJECTORIES_H_
+
+// BACK_UP: 1.05m of wheel travel in 2.52s
+static constexpr TrajectoryPoint BACK_UP_POINTS[] = {
+  {      0,      0,      0,      0,      0,      0, {      0,      0,      0,      0 }, {      0,      0,      0,      0 } },
+  {      0,     -2,      0,    -50,      0,      0, {   -470,    470,   -470,    470 }, {     -3,      3,     -3,      3 } },
+  {      0,     -5,      0,   -100,      0,      0, {   -940,    940,   -940,    940 }, {     -8,      8,     -8,      8 } },
+  {      0,    -11,      0,   -150,      0,      0, {  -1410,   1410,  -1410,   1410 }, {    -18,     18,    -18,     18 } },
+  {      0,    -20,      0,   -200,      0,      0, {  -1880,   1880,  -1880,   1880 }, {    -31,     31,    -31,     31 } },
+  {      0,    -31,      0,   -250,      0,      0, {  -2350,   2350,  -2350,   2350 }, {    -49,     49,    -49,     49 } },
+  {      0,    -45,      0,   -300,      0,      0, {  -2820,   2820,  -2820,   2820 }, {    -71,     71,    -71,     71 } },
+  {      0,    -61,      0,   -350,      0,      0, {  -3290,   3290,  -3290,   3290 }, {    -96,     96,    -96,     96 } },
+  {      0,    -80,      0,   -400,      0,      0, {  -3760,   3760,  -3760,   3760 }, {   -125,    125,   -125,    125 } },
+  {      0,   -101,      0,   -450,      0,      0, {  -4230,   4230,  -4230,   4230 }, {   -159,    159,   -159,    159 } },
+  {      0,   -125,      0,   -500,      0,      0, {  -4699,   4699,  -4699,   4699 }, {   -196,    196,   -196,    196 } },
+  {      0,   -151,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {   -237,    237,   -237,    237 } },
+  {      0,   -178,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {   -278,    278,   -278,    278 } },
+  {      0,   -204,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {   -320,    320,   -320,    320 } },
+  {      0,   -231,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {   -361,    361,   -361,    361 } },
+  {      0,   -257,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {   -403,    403,   -403,    403 } },
+  {      0,   -284,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {   -444,    444,   -444,    444 } },
+  {      0,   -310,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {   -486,    486,   -486,    486 } },
+  {      0,   -337,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {   -527,    527,   -527,    527 } },
+  {      0,   -363,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {   -569,    569,   -569,    569 } },
+  {      0,   -390,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {   -610,    610,   -610,    610 } },
+  {      0,   -416,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {   -652,    652,   -652,    652 } },
+  {      0,   -443,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {   -693,    693,   -693,    693 } },
+  {      0,   -469,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {   -735,    735,   -735,    735 } },
+  {      0,   -496,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {   -776,    776,   -776,    776 } },
+  {      0,   -522,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {   -818,    818,   -818,    818 } },
+  {      0,   -549,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {   -859,    859,   -859,    859 } },
+  {      0,   -575,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {   -901,    901,   -901,    901 } },
+  {      0,   -602,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {   -942,    942,   -942,    942 } },
+  {      0,   -628,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {   -984,    984,   -984,    984 } },
+  {      0,   -655,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {  -1025,   1025,  -1025,   1025 } },
+  {      0,   -681,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {  -1067,   1067,  -1067,   1067 } },
+  {      0,   -708,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {  -1108,   1108,  -1108,   1108 } },
+  {      0,   -734,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {  -1150,   1150,  -1150,   1150 } },
+  {      0,   -761,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {  -1191,   1191,  -1191,   1191 } },
+  {      0,   -787,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {  -1233,   1233,  -1233,   1233 } },
+  {      0,   -814,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {  -1274,   1274,  -1274,   1274 } },
+  {      0,   -840,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {  -1316,   1316,  -1316,   1316 } },
+  {      0,   -867,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {  -1357,   1357,  -1357,   1357 } },
+  {      0,   -893,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {  -1399,   1399,  -1399,   1399 } },
+  {      0,   -919,      0,   -517,      0,      0, {  -4857,   4857,  -4857,   4857 }, {  -1440,   1440,  -1440,   1440 } },
+  {      0,   -944,      0,   -467,      0,      0, {  -4387,   4387,  -4387,   4387 }, {  -1479,   1479,  -1479,   1479 } },
+  {      0,   -966,      0,   -417,      0,      0, {  -3917,   3917,  -3917,   3917 }, {  -1513,   1513,  -1513,   1513 } },
+  {      0,   -986,      0,   -367,      0,      0, {  -3448,   3448,  -3448,   3448 }, {  -1544,   1544,  -1544,   1544 } },
+  {      0,  -1003,      0,   -317,      0,      0, {  -2978,   2978,  -2978,   2978 }, {  -1571,   1571,  -1571,   1571 } },
+  {      0,  -1017,      0,   -267,      0,      0, {  -2508,   2508,  -2508,   2508 }, {  -1594,   1594,  -1594,   1594 } },
+  {      0,  -1029,      0,   -217,      0,      0, {  -2038,   2038,  -2038,   2038 }, {  -1613,   1613,  -1613,   1613 } },
+  {      0,  -1039,      0,   -167,      0,      0, {  -1568,   1568,  -1568,   1568 }, {  -1628,   1628,  -1628,   1628 } },
+  {      0,  -1046,      0,   -117,      0,      0, {  -1098,   1098,  -1098,   1098 }, {  -1639,   1639,  -1639,   1639 } },
+  {      0,  -1051,      0,    -67,      0,      0, {   -628,    628,   -628,    628 }, {  -1646,   1646,  -1646,   1646 } },
+  {      0,  -1052,      0,    -17,      0,      0, {   -158,    158,   -158,    158 }, {  -1649,   1649,  -1649,   1649 } },
+  {      0,  -1053,      0,      0,      0,      0, {      0,      0,      0,      0 }, {  -1650,   1650,  -1650,   1650 } },
+};
+static constexpr Trajectory BACK_UP = { BACK_UP_POINTS, 52, 50 };
+
+// COLLECT: 0.64m of wheel travel in 3.25s
+static constexpr TrajectoryPoint COLLECT_POINTS[] = {
+  {      0,  -1053,      0,      0,      0,      0, {      0,      0,      0,      0 }, {      0,      0,      0,      0 } },
+  {      0,  -1052,      0,     50,      0,      0, {    470,   -470,    470,   -470 }, {      2,     -2,      2,     -2 } },
+  {      0,  -1048,      0,    100,      0,      0, {    940,   -940,    940,   -940 }, {      8,     -8,      8,     -8 } },
+  {      0,  -1042,      0,    150,      0,      0, {   1410,  -1410,   1410,  -1410 }, {     18,    -18,     18,    -18 } },
+  {      0,  -1033,      0,    200,      0,      0, {   1880,  -1880,   1880,  -1880 }, {     31,    -31,     31,    -31 } },
+  {      0,  -1023,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {     48,    -48,     48,    -48 } },
+  {      0,  -1012,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {     64,    -64,     64,    -64 } },
+  {      0,  -1002,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {     81,    -81,     81,    -81 } },
+  {      0,   -991,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {     97,    -97,     97,    -97 } },
+  {      0,   -981,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    113,   -113,    113,   -113 } },
+  {      0,   -970,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    130,   -130,    130,   -130 } },
+  {      0,   -960,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    146,   -146,    146,   -146 } },
+  {      0,   -949,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    163,   -163,    163,   -163 } },
+  {      0,   -939,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    179,   -179,    179,   -179 } },
+  {      0,   -928,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    196,   -196,    196,   -196 } },
+  {      0,   -918,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    212,   -212,    212,   -212 } },
+  {      0,   -907,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    229,   -229,    229,   -229 } },
+  {      0,   -897,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    245,   -245,    245,   -245 } },
+  {      0,   -886,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    262,   -262,    262,   -262 } },
+  {      0,   -876,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    278,   -278,    278,   -278 } },
+  {      0,   -865,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    294,   -294,    294,   -294 } },
+  {      0,   -855,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    311,   -311,    311,   -311 } },
+  {      0,   -844,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    327,   -327,    327,   -327 } },
+  {      0,   -834,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    344,   -344,    344,   -344 } },
+  {      0,   -823,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    360,   -360,    360,   -360 } },
+  {      0,   -813,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    377,   -377,    377,   -377 } },
+  {      0,   -802,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    393,   -393,    393,   -393 } },
+  {      0,   -792,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    410,   -410,    410,   -410 } },
+  {      0,   -781,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    426,   -426,    426,   -426 } },
+  {      0,   -771,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    442,   -442,    442,   -442 } },
+  {      0,   -760,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    459,   -459,    459,   -459 } },
+  {      0,   -750,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    475,   -475,    475,   -475 } },
+  {      0,   -739,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    492,   -492,    492,   -492 } },
+  {      0,   -729,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    508,   -508,    508,   -508 } },
+  {      0,   -718,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    525,   -525,    525,   -525 } },
+  {      0,   -708,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    541,   -541,    541,   -541 } },
+  {      0,   -697,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    558,   -558,    558,   -558 } },
+  {      0,   -687,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    574,   -574,    574,   -574 } },
+  {      0,   -676,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    590,   -590,    590,   -590 } },
+  {      0,   -666,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    607,   -607,    607,   -607 } },
+  {      0,   -655,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    623,   -623,    623,   -623 } },
+  {      0,   -645,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    640,   -640,    640,   -640 } },
+  {      0,   -634,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    656,   -656,    656,   -656 } },
+  {      0,   -624,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    673,   -673,    673,   -673 } },
+  {      0,   -613,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    689,   -689,    689,   -689 } },
+  {      0,   -603,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    706,   -706,    706,   -706 } },
+  {      0,   -592,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    722,   -722,    722,   -722 } },
+  {      0,   -582,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    739,   -739,    739,   -739 } },
+  {      0,   -571,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    755,   -755,    755,   -755 } },
+  {      0,   -561,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    771,   -771,    771,   -771 } },
+  {      0,   -550,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    788,   -788,    788,   -788 } },
+  {      0,   -540,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    804,   -804,    804,   -804 } },
+  {      0,   -529,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    821,   -821,    821,   -821 } },
+  {      0,   -519,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    837,   -837,    837,   -837 } },
+  {      0,   -508,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    854,   -854,    854,   -854 } },
+  {      0,   -498,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    870,   -870,    870,   -870 } },
+  {      0,   -487,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    887,   -887,    887,   -887 } },
+  {      0,   -477,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    903,   -903,    903,   -903 } },
+  {      0,   -466,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    919,   -919,    919,   -919 } },
+  {      0,   -456,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    936,   -936,    936,   -936 } },
+  {      0,   -445,      0,    210,      0,      0, {   1974,  -1974,   1974,  -1974 }, {    952,   -952,    952,   -952 } },
+  {      0,   -435,      0,    198,      0,      0, {   1862,  -1862,   1862,  -1862 }, {    969,   -969,    969,   -969 } },
+  {      0,   -426,      0,    148,      0,      0, {   1392,  -1392,   1392,  -1392 }, {    982,   -982,    982,   -982 } },
+  {      0,   -420,      0,     98,      0,      0, {    922,   -922,    922,   -922 }, {    992,   -992,    992,   -992 } },
+  {      0,   -416,      0,     48,      0,      0, {    452,   -452,    452,   -452 }, {    998,   -998,    998,   -998 } },
+  {      0,   -415,      0,      0,      0,      0, {      0,      0,      0,      0 }, {    999,   -999,    999,   -999 } },
+};
+static constexpr Trajectory COLLECT = { COLLECT_POINTS, 66, 50 };
+
+// BACK_OFF: 0.67m of wheel travel in 1.79s
+static constexpr TrajectoryPoint BACK_OFF_POINTS[] = {
+  {      0,   -415,      0,      0,      0,      0, {      0,      0,      0,      0 }, {      0,      0,      0,      0 } },
+  {      0,   -416,      0,    -50,      0,      0, {   -470,    470,   -470,    470 }, {     -2,      2,     -2,      2 } },
+  {      0,   -420,      0,   -100,      0,      0, {   -940,    940,   -940,    940 }, {     -8,      8,     -8,      8 } },
+  {      0,   -426,      0,   -150,      0,      0, {  -1410,   1410,  -1410,   1410 }, {    -18,     18,    -18,     18 } },
+  {      0,   -435,      0,   -200,      0,      0, {  -1880,   1880,  -1880,   1880 }, {    -31,     31,    -31,     31 } },
+  {      0,   -446,      0,   -250,      0,      0, {  -2350,   2350,  -2350,   2350 }, {    -49,     49,    -49,     49 } },
+  {      0,   -460,      0,   -300,      0,      0, {  -2820,   2820,  -2820,   2820 }, {    -70,     70,    -70,     70 } },
+  {      0,   -476,      0,   -350,      0,      0, {  -3290,   3290,  -3290,   3290 }, {    -96,     96,    -96,     96 } },
+  {      0,   -495,      0,   -400,      0,      0, {  -3760,   3760,  -3760,   3760 }, {   -125,    125,   -125,    125 } },
+  {      0,   -516,      0,   -450,      0,      0, {  -4230,   4230,  -4230,   4230 }, {   -159,    159,   -159,    159 } },
+  {      0,   -540,      0,   -500,      0,      0, {  -4699,   4699,  -4699,   4699 }, {   -196,    196,   -196,    196 } },
+  {      0,   -566,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {   -237,    237,   -237,    237 } },
+  {      0,   -593,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {   -278,    278,   -278,    278 } },
+  {      0,   -619,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {   -320,    320,   -320,    320 } },
+  {      0,   -646,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {   -361,    361,   -361,    361 } },
+  {      0,   -672,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {   -403,    403,   -403,    403 } },
+  {      0,   -699,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {   -444,    444,   -444,    444 } },
+  {      0,   -725,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {   -486,    486,   -486,    486 } },
+  {      0,   -752,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {   -527,    527,   -527,    527 } },
+  {      0,   -778,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {   -569,    569,   -569,    569 } },
+  {      0,   -805,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {   -610,    610,   -610,    610 } },
+  {      0,   -831,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {   -652,    652,   -652,    652 } },
+  {      0,   -858,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {   -693,    693,   -693,    693 } },
+  {      0,   -884,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {   -735,    735,   -735,    735 } },
+  {      0,   -911,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {   -776,    776,   -776,    776 } },
+  {      0,   -937,      0,   -530,      0,      0, {  -4981,   4981,  -4981,   4981 }, {   -818,    818,   -818,    818 } },
+  {      0,   -963,      0,   -494,      0,      0, {  -4644,   4644,  -4644,   4644 }, {   -858,    858,   -858,    858 } },
+  {      0,   -986,      0,   -444,      0,      0, {  -4175,   4175,  -4175,   4175 }, {   -895,    895,   -895,    895 } },
+  {      0,  -1007,      0,   -394,      0,      0, {  -3705,   3705,  -3705,   3705 }, {   -928,    928,   -928,    928 } },
+  {      0,  -1026,      0,   -344,      0,      0, {  -3235,   3235,  -3235,   3235 }, {   -957,    957,   -957,    957 } },
+  {      0,  -1042,      0,   -294,      0,      0, {  -2765,   2765,  -2765,   2765 }, {   -982,    982,   -982,    982 } },
+  {      0,  -1055,      0,   -244,      0,      0, {  -2295,   2295,  -2295,   2295 }, {  -1003,   1003,  -1003,   1003 } },
+  {      0,  -1066,      0,   -194,      0,      0, {  -1825,   1825,  -1825,   1825 }, {  -1020,   1020,  -1020,   1020 } },
+  {      0,  -1075,      0,   -144,      0,      0, {  -1355,   1355,  -1355,   1355 }, {  -1033,   1033,  -1033,   1033 } },
+  {      0,  -1081,      0,    -94,      0,      0, {   -885,    885,   -885,    885 }, {  -1043,   1043,  -1043,   1043 } },
+  {      0,  -1084,      0,    -44,      0,      0, {   -415,    415,   -415,    415 }, {  -1048,   1048,  -1048,   1048 } },
+  {      0,  -1085,      0,      0,      0,      0, {      0,      0,      0,      0 }, {  -1050,   1050,  -1050,   1050 } },
+};
+static constexpr Trajectory BACK_OFF = { BACK_OFF_POINTS, 37, 50 };
+
+// SCORE: 1.60m of wheel travel in 3.54s
+static constexpr TrajectoryPoint SCORE_POINTS[] = {
+  {      0,  -1085,      0,      0,      0,      0, {      0,      0,      0,      0 }, {      0,      0,      0,      0 } },
+  {      0,  -1083,      0,     50,      0,      0, {    470,   -470,    470,   -470 }, {      3,     -3,      3,     -3 } },
+  {      0,  -1080,      0,    100,      0,      0, {    940,   -940,    940,   -940 }, {      8,     -8,      8,     -8 } },
+  {      0,  -1074,      0,    150,      0,      0, {   1410,  -1410,   1410,  -1410 }, {     18,    -18,     18,    -18 } },
+  {      0,  -1065,      0,    200,      0,      0, {   1880,  -1880,   1880,  -1880 }, {     31,    -31,     31,    -31 } },
+  {      0,  -1054,      0,    250,      0,      0, {   2350,  -2350,   2350,  -2350 }, {     49,    -49,     49,    -49 } },
+  {      0,  -1040,      0,    300,      0,      0, {   2820,  -2820,   2820,  -2820 }, {     70,    -70,     70,    -70 } },
+  {      0,  -1024,      0,    350,      0,      0, {   3290,  -3290,   3290,  -3290 }, {     96,    -96,     96,    -96 } },
+  {      0,  -1005,      0,    400,      0,      0, {   3760,  -3760,   3760,  -3760 }, {    125,   -125,    125,   -125 } },
+  {      0,   -984,      0,    450,      0,      0, {   4230,  -4230,   4230,  -4230 }, {    159,   -159,    159,   -159 } },
+  {      0,   -960,      0,    500,      0,      0, {   4699,  -4699,   4699,  -4699 }, {    196,   -196,    196,   -196 } },
+  {      0,   -934,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {    237,   -237,    237,   -237 } },
+  {      0,   -907,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {    278,   -278,    278,   -278 } },
+  {      0,   -881,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {    320,   -320,    320,   -320 } },
+  {      0,   -854,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {    361,   -361,    361,   -361 } },
+  {      0,   -828,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {    403,   -403,    403,   -403 } },
+  {      0,   -801,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {    444,   -444,    444,   -444 } },
+  {      0,   -775,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {    486,   -486,    486,   -486 } },
+  {      0,   -748,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {    527,   -527,    527,   -527 } },
+  {      0,   -722,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {    569,   -569,    569,   -569 } },
+  {      0,   -695,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {    610,   -610,    610,   -610 } },
+  {      0,   -669,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {    652,   -652,    652,   -652 } },
+  {      0,   -642,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {    693,   -693,    693,   -693 } },
+  {      0,   -616,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {    735,   -735,    735,   -735 } },
+  {      0,   -589,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {    776,   -776,    776,   -776 } },
+  {      0,   -563,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {    818,   -818,    818,   -818 } },
+  {      0,   -536,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {    859,   -859,    859,   -859 } },
+  {      0,   -510,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {    901,   -901,    901,   -901 } },
+  {      0,   -483,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {    942,   -942,    942,   -942 } },
+  {      0,   -457,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {    984,   -984,    984,   -984 } },
+  {      0,   -430,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {   1025,  -1025,   1025,  -1025 } },
+  {      0,   -404,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {   1067,  -1067,   1067,  -1067 } },
+  {      0,   -377,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {   1108,  -1108,   1108,  -1108 } },
+  {      0,   -351,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {   1150,  -1150,   1150,  -1150 } },
+  {      0,   -324,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {   1191,  -1191,   1191,  -1191 } },
+  {      0,   -298,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {   1233,  -1233,   1233,  -1233 } },
+  {      0,   -271,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {   1274,  -1274,   1274,  -1274 } },
+  {      0,   -245,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {   1316,  -1316,   1316,  -1316 } },
+  {      0,   -218,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {   1357,  -1357,   1357,  -1357 } },
+  {      0,   -192,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {   1399,  -1399,   1399,  -1399 } },
+  {      0,   -165,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {   1440,  -1440,   1440,  -1440 } },
+  {      0,   -139,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {   1482,  -1482,   1482,  -1482 } },
+  {      0,   -112,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {   1523,  -1523,   1523,  -1523 } },
+  {      0,    -86,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {   1565,  -1565,   1565,  -1565 } },
+  {      0,    -59,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {   1607,  -1607,   1607,  -1607 } },
+  {      0,    -33,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {   1648,  -1648,   1648,  -1648 } },
+  {      0,     -6,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {   1690,  -1690,   1690,  -1690 } },
+  {      0,     20,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {   1731,  -1731,   1731,  -1731 } },
+  {      0,     47,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {   1773,  -1773,   1773,  -1773 } },
+  {      0,     73,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {   1814,  -1814,   1814,  -1814 } },
+  {      0,    100,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {   1856,  -1856,   1856,  -1856 } },
+  {      0,    126,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {   1897,  -1897,   1897,  -1897 } },
+  {      0,    153,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {   1939,  -1939,   1939,  -1939 } },
+  {      0,    179,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {   1980,  -1980,   1980,  -1980 } },
+  {      0,    206,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {   2022,  -2022,   2022,  -2022 } },
+  {      0,    232,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {   2063,  -2063,   2063,  -2063 } },
+  {      0,    259,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {   2105,  -2105,   2105,  -2105 } },
+  {      0,    285,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {   2146,  -2146,   2146,  -2146 } },
+  {      0,    312,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {   2188,  -2188,   2188,  -2188 } },
+  {      0,    338,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {   2229,  -2229,   2229,  -2229 } },
+  {      0,    365,      0,    530,      0,      0, {   4981,  -4981,   4981,  -4981 }, {   2271,  -2271,   2271,  -2271 } },
+  {      0,    390,      0,    491,      0,      0, {   4618,  -4618,   4618,  -4618 }, {   2311,  -2311,   2311,  -2311 } },
+  {      0,    414,      0,    441,      0,      0, {   4148,  -4148,   4148,  -4148 }, {   2348,  -2348,   2348,  -2348 } },
+  {      0,    434,      0,    391,      0,      0, {   3678,  -3678,   3678,  -3678 }, {   2380,  -2380,   2380,  -2380 } },
+  {      0,    453,      0,    341,      0,      0, {   3208,  -3208,   3208,  -3208 }, {   2409,  -2409,   2409,  -2409 } },
+  {      0,    469,      0,    291,      0,      0, {   2738,  -2738,   2738,  -2738 }, {   2434,  -2434,   2434,  -2434 } },
+  {      0,    482,      0,    241,      0,      0, {   2268,  -2268,   2268,  -2268 }, {   2454,  -2454,   2454,  -2454 } },
+  {      0,    493,      0,    191,      0,      0, {   1798,  -1798,   1798,  -1798 }, {   2471,  -2471,   2471,  -2471 } },
+  {      0,    501,      0,    141,      0,      0, {   1328,  -1328,   1328,  -1328 }, {   2484,  -2484,   2484,  -2484 } },
+  {      0,    507,      0,     91,      0,      0, {    858,   -858,    858,   -858 }, {   2493,  -2493,   2493,  -2493 } },
+  {      0,    509,      0,     41,      0,      0, {    388,   -388,    388,   -388 }, {   2498,  -2498,   2498,  -2498 } },
+  {      0,    511,      0,      0,      0,      0, {      0,      0,      0,      0 }, {   2500,  -2500,   2500,  -2500 } },
+};
+static constexpr Trajectory SCORE = { SCORE_POINTS, 72, 50 };
+
+#endif
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdint.h>
+
+#ifndef _TRAJECTORY_H_
+#define _TRAJECTORY_H_
+
+// Units of the quantized fields in `TrajectoryPoint`, per metre, radian, percent and
+// wheel revolution.  They set both the resolution and the range (+-32767 units).
+#define _TRAJECTORY_H_LENGTH_SCALE 1000
+#define _TRAJECTORY_H_ANGLE_SCALE 1000
+#define _TRAJECTORY_H_SPEED_SCALE 100
+#define _TRAJECTORY_H_POSITION_SCALE 500
+
+/**
+ * One sample of a trajectory, quantized to 16 bits a field.  Pose and velocity are
+ * kept for reporting where the robot should be; the wheels only need the last two.
+ * Wheels are in the order front-left, front-right, back-left, back-right, in the
+ * motors' own direction (the right side is mounted reversed).
+ */
+struct TrajectoryPoint {
+  int16_t x, y;                 // field position, mm
+  int16_t heading;              // mrad, clockwise from +y
+  int16_t forward, strafe;      // body-frame velocity, mm/s
+  int16_t turn;                 // mrad/s, clockwise
+  int16_t wheelSpeed[4];        // hundredths of a percent of free speed
+  int16_t wheelPosition[4];     // 1/500 revolution, from the start of the trajectory
+};
+
+/**
+ * A trajectory the drive base can follow, as a table of points one `period` apart.
+ * The tables are worked out on a computer by `host/tools/trajectory` and compiled into
+ * the program as constant data (see `Trajectories.h`), so following one costs nothing
+ * up front, and nothing on the heap.
+ */
+struct Trajectory {
+  const TrajectoryPoint* points;
+  int32_t count;
+  int32_t period;   // milliseconds between points
+
+  // Length of the trajectory, in milliseconds.
+  constexpr int32_t duration() const { return (this->count - 1) * this->period; }
+};
+
+/**
+ * A trajectory at one moment, interpolated between its two nearest points and scaled
+ * back to ordinary units.  The wheel accelerations are the slope between those points.
+ */
+struct TrajectorySample {
+  double x, y, heading;             // metres, radians
+  double forward, strafe, turn;     // metres per second, radians per second
+  double wheelSpeed[4];             // percent of free speed
+  double wheelAcceleration[4];      // percent per second
+  double wheelPosition[4];          // revolutions
+};
+
+/**
+ * Returns `trajectory` at `time` milliseconds from its start.  Times before the start
+ * or after the end give the first or last point, standing still.
+ */
+TrajectorySample sampleTrajectory(const Trajectory& trajectory, double time);
+
+#endif
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "vex.h"
+#include "commands/Scheduler.h"
+
+#ifndef _WATCHDOG_H_
+#define _WATCHDOG_H_
+
+// Longest a tick of the control loop may take, in microseconds.
+#define _WATCHDOG_H_BUDGET 2000
+
+// Overruns it takes to step down a level.
+#define _WATCHDOG_H_MISSES 3
+
+// Ticks in a row within budget it takes to forgive earlier overruns and step back up.
+#define _WATCHDOG_H_RECOVER 200
+
+// Ticks between updates of non-critical subsystems at Level::REDUCED_RATE.
+#define _WATCHDOG_H_SLOW_INTERVAL 4
+
+// Number of recent overruns kept.
+#define _WATCHDOG_H_LOG 8
+
+/**
+ * Keeps an eye on how long each tick of the control loop takes.
+ *
+ * Every tick that runs over budget is logged along with whichever subsystem (or the
+ * running commands) took the longest.  After _WATCHDOG_H_MISSES of them the watchdog
+ * steps down a level:
+ *  - Level::NO_EXTRAS - optional work such as the dashboard should stop; anything of
+ *    that kind checks `extrasEnabled()`.
+ *  - Level::REDUCED_RATE - on top of that, the subsystems given to `setNonCritical()`
+ *    are only updated every _WATCHDOG_H_SLOW_INTERVAL ticks.
+ * After _WATCHDOG_H_RECOVER good ticks in a row it steps back up one level.
+ *
+ * The drive and lift are never made non-critical, so they are updated every tick no
+ * matter what; they should also come first in the scheduler's subsystem list so that
+ * a slow subsystem can't delay them within a tick.
+ */
+class Watchdog {
+
+  public:
+
+    enum Level {
+      NORMAL,         // Everything runs
+      NO_EXTRAS,      // Optional work is off
+      REDUCED_RATE    // Optional work is off and non-critical subsystems run slower
+    };
+
+    /**
+     * One tick that ran over budget.
+     */
+    struct Overrun {
+      uint32_t time;        // when, in milliseconds since the program started
+      uint32_t duration;    // how long the tick took, in microseconds
+      int32_t offender;     // index of the slowest subsystem in the scheduler, or -1 for commands
+    };
+
+    /**
+     * Creates a new instance of `Watchdog`.
+     *
+     * @param
+     *    scheduler - the scheduler the control loop runs, which times each subsystem.
+     *    budget - longest a tick may take, in microseconds.
+     */
+    Watchdog(Scheduler* scheduler, uint32_t budget = _WATCHDOG_H_BUDGET);
+
+    // Let `subsystem` run at a lower rate when the loop keeps overrunning.
+    void setNonCritical(Subsystem* subsystem);
+
+    /**
+     * Checks one tick against the budget.  Call this at the end of every tick with the
+     * times (in microseconds) it started and ended.
+     */
+    void check(uint64_t start, uint64_t end);
+
+    Level getLevel();
+
+    // Whether optional work (dashboard, telemetry) should run.
+    bool extrasEnabled();
+
+    // Total number of overruns since the program started.
+    uint32_t getOverrunCount();
+
+    // The `n`th most recent overrun, 0 being the latest.  `n` must be less than
+    // both _WATCHDOG_H_LOG and `getOverrunCount()`.
+    const Overrun& getOverrun(int32_t n);
+
+  private:
+
+    // Set every non-critical subsystem's rate for the current level.
+    void applyLevel();
+
+    Scheduler* scheduler;
+    uint32_t budget;
+
+    Subsystem* nonCritical[_SCHEDULER_H_MAX_SUBSYSTEMS];
+    int32_t nonCriticalCount;
+
+    Level level;
+    int32_t misses;
+    int32_t goodTicks;
+
+    Overrun log[_WATCHDOG_H_LOG];
+    uint32_t overruns;
+};
+
+#endif
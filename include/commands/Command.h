@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "subsystems/Subsystem.h"
+
+#ifndef _COMMAND_H_
+#define _COMMAND_H_
+
+/**
+ * The maximum number of subsystems that a single `Command` may require.
+ * Groups take on the requirements of all of their children, so this needs to be
+ * large enough to hold the union of every subsystem on the robot.
+ */
+#define _COMMAND_H_MAX_REQUIREMENTS 6
+
+class CommandPoolBase;
+
+/**
+ * Abstract base class for a timed or conditional action that runs across several
+ * ticks, such as "raise the lift to the lower tower" or "drive forward until the
+ * cube is in the intake".  Commands are stepped once per tick by the `Scheduler`,
+ * so they must never block; anything that would have been a `task::sleep()` should
+ * instead be expressed as a condition in `isFinished()`.
+ *
+ * The lifecycle of a command is:
+ *  - `initialize()` is called once, when the command is scheduled.
+ *  - `execute()` is called once per tick while the command is running.
+ *  - `isFinished()` is checked once per tick, right after `execute()`.
+ *  - `end(interrupted)` is called once, either when `isFinished()` returns true
+ *    (`interrupted == false`) or when the command is cancelled or preempted by
+ *    another command (`interrupted == true`).
+ *
+ * Every command declares which subsystems it requires.  While a command holds a
+ * subsystem, the `Scheduler` stops calling that subsystem's own `update()`, and no
+ * other command may use it unless it has an equal or higher priority, in which case
+ * the running command is interrupted.
+ *
+ * Commands are meant to be obtained from a `CommandPool` rather than with `new`, so
+ * that nothing allocates during a match.  A command that came from a pool is
+ * returned to it automatically once the `Scheduler` is done with it.
+ */
+class Command {
+
+  public:
+
+    /**
+     * Called once when the command is scheduled.  Does nothing by default.
+     */
+    virtual void initialize();
+
+    /**
+     * Called once per tick while the command is running.  Does nothing by default.
+     */
+    virtual void execute();
+
+    /**
+     * Returns whether or not the command has completed.  Checked once per tick after
+     * `execute()`.  By default, commands never finish on their own.
+     */
+    virtual bool isFinished();
+
+    /**
+     * Called once when the command stops running.
+     *
+     * @param
+     *    interrupted - false if the command ended because `isFinished()` returned true,
+     *                  true if it was cancelled or preempted.
+     */
+    virtual void end(bool interrupted);
+
+    /**
+     * Returns true if this command requires the given subsystem.
+     */
+    bool hasRequirement(Subsystem* subsystem) const;
+
+    /**
+     * Returns true if this command shares at least one required subsystem with `other`.
+     */
+    bool conflictsWith(const Command* other) const;
+
+    // Accessors for the requirements of this command, mostly used by `CommandGroup`.
+    int32_t getRequirementCount() const;
+    Subsystem* getRequirement(int32_t index) const;
+
+    // Accessors for the priority of this command.  Higher values take precedence.
+    int32_t getPriority() const;
+    void setPriority(int32_t priority);
+
+    /**
+     * Returns this command to the `CommandPool` it was acquired from.  The command must
+     * not be used afterwards.  Commands that did not come from a pool are left alone.
+     */
+    void release();
+
+    virtual ~Command();
+
+  protected:
+
+    /**
+     * Creates a new command with no requirements.
+     *
+     * @param
+     *    priority - The priority of this command, used to decide which command wins
+     *               when two of them require the same subsystem.
+     */
+    Command(int32_t priority = 0);
+
+    /**
+     * Declares that this command requires the given subsystem.  Should be called from
+     * the constructor of subclasses.  Duplicate requirements are ignored.
+     *
+     * @return false if the subsystem could not be added because the command already
+     *         has _COMMAND_H_MAX_REQUIREMENTS requirements, or if it is nullptr.
+     */
+    bool addRequirement(Subsystem* subsystem);
+
+  private:
+
+    // Lets pools mark the commands they construct as their own.
+    friend class CommandPoolBase;
+
+    Subsystem* requirements[_COMMAND_H_MAX_REQUIREMENTS];
+    int32_t requirementCount;
+    int32_t priority;
+
+    // The pool this command came from, or nullptr if it was not acquired from a pool.
+    CommandPoolBase* pool;
+};
+
+#endif
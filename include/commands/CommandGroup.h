@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "commands/Command.h"
+
+#ifndef _COMMANDGROUP_H_
+#define _COMMANDGROUP_H_
+
+// The maximum number of commands a single group may contain.
+#define _COMMANDGROUP_H_MAX_COMMANDS 8
+
+/**
+ * Abstract base class for a command made up of other commands.  A group requires
+ * every subsystem that any of its children require, so the `Scheduler` treats the
+ * whole group as a single unit when checking for conflicts.
+ *
+ * Children are owned by the group: when a group is released back to its pool, it
+ * releases all of its children as well.  Children must not also be scheduled on
+ * their own.
+ */
+class CommandGroup : public Command {
+
+  public:
+
+    /**
+     * Appends a command to this group and takes on its requirements.  The group owns
+     * the command either way: one that cannot be added is released straight away.
+     *
+     * @return false if the command was not added: it is nullptr (e.g. from an exhausted
+     *         `CommandPool`), the group already holds _COMMANDGROUP_H_MAX_COMMANDS, or it
+     *         shares a subsystem with another child that would run at the same time.
+     */
+    bool add(Command* command);
+
+    // Releases all of the children of this group.
+    ~CommandGroup() override;
+
+  protected:
+
+    CommandGroup(int32_t priority = 0);
+
+    // Whether children run at the same time, in which case no two may share a subsystem.
+    virtual bool runsChildrenTogether() const;
+
+    Command* commands[_COMMANDGROUP_H_MAX_COMMANDS];
+    int32_t commandCount;
+
+    // Whether each child is currently between its `initialize()` and `end()`.
+    bool running[_COMMANDGROUP_H_MAX_COMMANDS];
+};
+
+/**
+ * Runs its children one after another, starting each one as soon as the previous one
+ * finishes.  Finishes when the last child finishes.
+ */
+class SequentialGroup : public CommandGroup {
+
+  public:
+
+    SequentialGroup(int32_t priority = 0);
+
+    void initialize() override;
+    void execute() override;
+    bool isFinished() override;
+    void end(bool interrupted) override;
+
+  protected:
+
+    bool runsChildrenTogether() const override;
+
+  private:
+
+    // Index of the child currently running.
+    int32_t current;
+};
+
+/**
+ * Runs all of its children at the same time.  Finishes once every child has finished.
+ */
+class ParallelGroup : public CommandGroup {
+
+  public:
+
+    ParallelGroup(int32_t priority = 0);
+
+    void initialize() override;
+    void execute() override;
+    bool isFinished() override;
+    void end(bool interrupted) override;
+};
+
+/**
+ * Runs all of its children at the same time.  Finishes as soon as any one child
+ * finishes, interrupting the rest.
+ */
+class RaceGroup : public CommandGroup {
+
+  public:
+
+    RaceGroup(int32_t priority = 0);
+
+    void initialize() override;
+    void execute() override;
+    bool isFinished() override;
+    void end(bool interrupted) override;
+
+  private:
+
+    // Set once any child has finished.
+    bool finished;
+};
+
+#endif
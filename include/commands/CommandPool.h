@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "commands/Command.h"
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#ifndef _COMMANDPOOL_H_
+#define _COMMANDPOOL_H_
+
+/**
+ * Non-template base class of `CommandPool`, so that a `Command` can hand itself back
+ * to the pool it came from without knowing its concrete type.
+ */
+class CommandPoolBase {
+
+  public:
+
+    /**
+     * Destroys a command that was acquired from this pool and frees its slot.
+     */
+    virtual void release(Command* command) = 0;
+
+  protected:
+
+    // Marks `command` as belonging to this pool.
+    void adopt(Command* command) { command->pool = this; }
+
+};
+
+/**
+ * A fixed-size pool of `N` commands of type `T`.  All of the storage for the commands
+ * is reserved up front (typically as a global), so acquiring and releasing commands
+ * during a match never touches the heap.
+ *
+ * Usage:
+ *
+ *    CommandPool<WaitCommand, 4> waitPool;
+ *    ...
+ *    scheduler.schedule(waitPool.acquire(500));
+ */
+template <typename T, int32_t N>
+class CommandPool : public CommandPoolBase {
+
+  public:
+
+    CommandPool() {
+      for(int32_t i = 0; i < N; i++) this->used[i] = false;
+    }
+
+    /**
+     * Constructs a new `T` in a free slot of the pool, forwarding `args` to its
+     * constructor.  Returns nullptr if every slot is already in use; the `Scheduler`
+     * and `CommandGroup` both ignore nullptr commands, so an exhausted pool degrades to
+     * the command simply not running.
+     */
+    template <typename... Args>
+    T* acquire(Args&&... args) {
+      for(int32_t i = 0; i < N; i++) {
+        if(this->used[i]) continue;
+        this->used[i] = true;
+        T* command = new (&this->slots[i]) T(std::forward<Args>(args)...);
+        this->adopt(command);
+        return command;
+      }
+      return nullptr;
+    }
+
+    /**
+     * Destroys `command` and frees its slot.  Commands from other pools are ignored.
+     */
+    void release(Command* command) override {
+      for(int32_t i = 0; i < N; i++) {
+        T* slot = reinterpret_cast<T*>(&this->slots[i]);
+        if(this->used[i] && slot == static_cast<T*>(command)) {
+          slot->~T();
+          this->used[i] = false;
+          return;
+        }
+      }
+    }
+
+    // Returns the number of slots that are currently free.
+    int32_t available() const {
+      int32_t count = 0;
+      for(int32_t i = 0; i < N; i++) if(!this->used[i]) count++;
+      return count;
+    }
+
+  private:
+
+    // Raw, suitably aligned storage for each of the commands, and whether it is in use.
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type slots[N];
+    bool used[N];
+
+};
+
+#endif
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "commands/Command.h"
+#include "subsystems/MecanumDriveTank.h"
+
+#ifndef _DRIVECOMMAND_H_
+#define _DRIVECOMMAND_H_
+
+/**
+ * A command that drives the mecanum base at a fixed power until it has travelled a
+ * given distance forwards or backwards, then brakes.  Requires the drive base.
+ *
+ * The distance is measured by the wheel encoders, so unlike a timed move it lands in
+ * the same place regardless of battery level or how long the robot took to get going.
+ * Pure strafes and turns don't change the forward distance; run those in a `RaceGroup`
+ * with some other ending condition instead.
+ */
+class DriveCommand : public Command {
+
+  public:
+
+    /**
+     * Creates a new instance of `DriveCommand`.
+     *
+     * @param
+     *    drive - The drive base to move.
+     *    forward, strafe, turn - Powers, -100...100, as for `MecanumDriveTank::drive()`.
+     *    distance - How far to travel, in wheel revolutions, before finishing.  The
+     *               direction is taken from `forward`.
+     */
+    DriveCommand( MecanumDriveTank* drive,
+                  int32_t forward,
+                  int32_t strafe,
+                  int32_t turn,
+                  double distance );
+
+    void initialize() override;
+    void execute() override;
+    bool isFinished() override;
+    void end(bool interrupted) override;
+
+  private:
+
+    MecanumDriveTank* drive;
+    int32_t forward, strafe, turn;
+    double distance;
+
+    // Encoder reading when the command started, so other commands' moves don't count.
+    double start;
+};
+
+#endif
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "commands/Command.h"
+#include <functional>
+
+#ifndef _INSTANTCOMMAND_H_
+#define _INSTANTCOMMAND_H_
+
+/**
+ * A command that runs a function once when it is started, and finishes right away.
+ * Useful for small one-off actions in the middle of a group, such as resetting an
+ * encoder.
+ */
+class InstantCommand : public Command {
+
+  public:
+
+    /**
+     * Creates a new instance of `InstantCommand`.
+     *
+     * @param
+     *    action - The function to run.
+     *    requirement - A subsystem that `action` touches, if any.
+     */
+    InstantCommand(std::function<void()> action, Subsystem* requirement = nullptr);
+
+    void initialize() override;
+    bool isFinished() override;
+
+  private:
+
+    std::function<void()> action;
+};
+
+#endif
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "commands/Command.h"
+#include "subsystems/RollerIntake.h"
+
+#ifndef _INTAKECOMMAND_H_
+#define _INTAKECOMMAND_H_
+
+/**
+ * A command that spins the `RollerIntake` at a fixed power and never finishes on its
+ * own; put it in a `RaceGroup` with whatever should stop it (a drive move, a
+ * `WaitCommand`, a `WaitUntilCommand`...).  The rollers are stopped when it ends.
+ * Requires the intake.
+ */
+class IntakeCommand : public Command {
+
+  public:
+
+    /**
+     * Creates a new instance of `IntakeCommand`.
+     *
+     * @param
+     *    intake - The intake to spin.
+     *    power - Roller power, -100...100, as for `RollerIntake::spin()`.
+     */
+    IntakeCommand(RollerIntake* intake, int32_t power);
+
+    void execute() override;
+    void end(bool interrupted) override;
+
+  private:
+
+    RollerIntake* intake;
+    int32_t power;
+};
+
+#endif
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "commands/Command.h"
+#include "subsystems/RD4BLift.h"
+
+#ifndef _LIFTCOMMAND_H_
+#define _LIFTCOMMAND_H_
+
+/**
+ * A command that moves the `RD4BLift` to one of its preset heights, and finishes once
+ * the lift gets there.  The lift keeps holding the preset after the command finishes,
+ * until it is given some other input.  Requires the lift.
+ */
+class LiftCommand : public Command {
+
+  public:
+
+    /**
+     * Creates a new instance of `LiftCommand`.
+     *
+     * @param
+     *    lift - The lift to move.
+     *    state - The preset to move to; one of State::GROUND, State::LOWER_TOWER or
+     *            State::UPPER_TOWER.
+     */
+    LiftCommand(RD4BLift* lift, RD4BLift::State state);
+
+    void initialize() override;
+    void execute() override;
+    bool isFinished() override;
+
+  private:
+
+    RD4BLift* lift;
+    RD4BLift::State state;
+};
+
+#endif
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "subsystems/Subsystem.h"
+#include "commands/Command.h"
+
+#ifndef _SCHEDULER_H_
+#define _SCHEDULER_H_
+
+// The maximum number of commands that may be running at the same time.
+#define _SCHEDULER_H_MAX_COMMANDS 8
+
+// The maximum number of subsystems the scheduler can be given.
+#define _SCHEDULER_H_MAX_SUBSYSTEMS 8
+
+/**
+ * Runs `Command`s alongside the regular subsystems, once per tick.
+ *
+ * The `Scheduler` is itself a `Subsystem`, and is meant to be the one thing updated in
+ * the main loop.  It is given the list of subsystems on the robot, and on every call
+ * to `update()` it:
+ *  - calls `update()` on every subsystem that is *not* currently required by a
+ *    running command, so driver control keeps working exactly as before; then
+ *  - steps every running command (`execute()`, then `isFinished()`), ending and
+ *    releasing the commands that have finished.
+ *
+ * When a newly scheduled command requires a subsystem that is already in use, the
+ * running command is interrupted if the new one has an equal or higher priority;
+ * otherwise the new command is rejected.
+ *
+ * Each subsystem's `update()` and the commands as a whole are timed on every tick, so
+ * that a `Watchdog` can tell which of them made a tick run long.  Subsystems can also
+ * be set to only update every few ticks, to shed load when the loop is overrunning.
+ *
+ * Nothing in here allocates; running commands are kept in a fixed-size array.
+ */
+class Scheduler : public Subsystem {
+
+  public:
+
+    /**
+     * Update every free subsystem, then step every running command.
+     * This should be called once per tick.
+     */
+    void update() override;
+
+    /**
+     * Creates a new instance of `Scheduler`.
+     *
+     * @param
+     *    subsystems - An array of the subsystems to update when no command requires them.
+     *                 The array itself is referenced, not copied, so it may be filled in
+     *                 after the scheduler is constructed.
+     *    count - The number of subsystems in the array.
+     */
+    Scheduler(Subsystem** subsystems, int32_t count);
+
+    /**
+     * Starts running a command, interrupting any lower or equal priority commands that
+     * require the same subsystems.  The command's `initialize()` is called immediately.
+     *
+     * @return true if the command was scheduled; false if it was nullptr, already
+     *         running, blocked by a higher priority command, or there was no room.
+     *         A rejected command is left untouched and still belongs to the caller.
+     */
+    bool schedule(Command* command);
+
+    /**
+     * Interrupts a running command.  Does nothing if the command isn't running.
+     */
+    void cancel(Command* command);
+
+    /**
+     * Interrupts every running command, e.g. when switching from autonomous to driver control.
+     */
+    void cancelAll();
+
+    // Returns true if the command is currently running.
+    bool isScheduled(const Command* command) const;
+
+    // Returns true if any running command requires the given subsystem.
+    bool isRequired(Subsystem* subsystem) const;
+
+    /**
+     * Only update `subsystem` every `ticks` ticks (1 is every tick).  Commands that
+     * require the subsystem still run every tick.
+     */
+    void setInterval(Subsystem* subsystem, int32_t ticks);
+
+    int32_t getSubsystemCount() const;
+    Subsystem* getSubsystem(int32_t index) const;
+
+    // How long the subsystem at `index` took to update on the last tick, in microseconds.
+    uint32_t getDuration(int32_t index) const;
+
+    // How long the running commands took on the last tick, in microseconds.
+    uint32_t getCommandDuration() const;
+
+  private:
+
+    // Ends the command in slot `index` and hands it back to its pool.
+    void finish(int32_t index, bool interrupted);
+
+    Subsystem** subsystems;
+    int32_t subsystemCount;
+
+    // Per subsystem: ticks between updates, and time taken on the last tick.
+    int32_t intervals[_SCHEDULER_H_MAX_SUBSYSTEMS];
+    uint32_t durations[_SCHEDULER_H_MAX_SUBSYSTEMS];
+    uint32_t commandDuration;
+    uint32_t ticks;
+
+    // Running commands; empty slots are nullptr.
+    Command* commands[_SCHEDULER_H_MAX_COMMANDS];
+};
+
+#endif
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "commands/Command.h"
+#include "subsystems/MecanumDriveTank.h"
+#include "subsystems/RD4BLift.h"
+#include "subsystems/RollerIntake.h"
+
+#ifndef _SCORECOMMAND_H_
+#define _SCORECOMMAND_H_
+
+// Drive power while creeping up to the tower, and the furthest to creep (revolutions)
+// if the robot never comes up against it.
+#define _SCORECOMMAND_H_APPROACH_POWER 25
+#define _SCORECOMMAND_H_APPROACH_DISTANCE 1.5
+
+// The approach has to cover this much (revolutions) before the drive stopping counts as
+// reaching the tower rather than not having got going yet.
+#define _SCORECOMMAND_H_APPROACH_START 0.1
+
+// Roller power while letting the cube go.  The cube is out once the rollers have turned
+// _SCORECOMMAND_H_RELEASE_TURNS revolutions and are spinning at
+// _SCORECOMMAND_H_RELEASE_FREE percent of that power, i.e. have nothing left to push.
+#define _SCORECOMMAND_H_RELEASE_POWER 50
+#define _SCORECOMMAND_H_RELEASE_TURNS 1.0
+#define _SCORECOMMAND_H_RELEASE_FREE 80
+
+// Drive power and distance (revolutions) to back away from the tower while lowering.
+#define _SCORECOMMAND_H_BACK_OFF_POWER 40
+#define _SCORECOMMAND_H_BACK_OFF_DISTANCE 0.5
+
+/**
+ * Scores the cube in the intake on a tower in one go: raise the lift to the tower's
+ * height, creep forward until the robot comes up against the tower, push the cube out,
+ * then back away while lowering the lift to the ground.  Requires the drive, lift and
+ * intake.
+ *
+ * Each phase is a state stepped once per tick by the scheduler, and each ends on a
+ * sensor reading (lift at its preset, drive stopped against the tower, rollers turning
+ * freely, encoders) rather than after a fixed time, so the macro takes only as long
+ * as the robot actually needs.  Cancelling it stops the drive and rollers and leaves
+ * the lift holding wherever it was going.
+ */
+class ScoreCommand : public Command {
+
+  public:
+
+    /**
+     * Phases of the macro, in order.
+     */
+    enum Phase {
+      RAISE,      // Lift moving up to the tower
+      APPROACH,   // Creeping forward to the tower
+      RELEASE,    // Rollers pushing the cube out
+      LOWER,      // Backing off while the lift goes back down
+      DONE
+    };
+
+    /**
+     * Creates a new instance of `ScoreCommand`.
+     *
+     * @param
+     *    drive, lift, intake - The subsystems to use.
+     *    tower - The lift preset for the tower; State::LOWER_TOWER or State::UPPER_TOWER.
+     */
+    ScoreCommand( MecanumDriveTank* drive,
+                  RD4BLift* lift,
+                  RollerIntake* intake,
+                  RD4BLift::State tower );
+
+    void initialize() override;
+    void execute() override;
+    bool isFinished() override;
+    void end(bool interrupted) override;
+
+    Phase getPhase();
+
+  private:
+
+    // Move on to `phase`, noting where the encoders were when it started.
+    void enter(Phase phase);
+
+    MecanumDriveTank* drive;
+    RD4BLift* lift;
+    RollerIntake* intake;
+    RD4BLift::State tower;
+
+    Phase phase;
+    double driveStart, rollerStart;
+};
+
+#endif
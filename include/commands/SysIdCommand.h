@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "commands/Command.h"
+#include "SysId.h"
+
+#ifndef _SYSIDCOMMAND_H_
+#define _SYSIDCOMMAND_H_
+
+// How fast the voltage rises in the ramp tests, in volts per second.  Slow enough that
+// the mechanism is never accelerating much, so the fit can separate kS and kV from kA.
+#define _SYSIDCOMMAND_H_DRIVE_RAMP 1.0
+#define _SYSIDCOMMAND_H_LIFT_RAMP 1.0
+
+// Voltage for the step tests.  The lift's is on top of the voltage that holds it up.
+#define _SYSIDCOMMAND_H_DRIVE_STEP 6.0
+#define _SYSIDCOMMAND_H_LIFT_STEP 3.0
+
+// The lift has started moving up once it is going this fast (percent).
+#define _SYSIDCOMMAND_H_BREAKAWAY 2
+
+// Furthest the drive base may go from where the test started, in revolutions.
+#define _SYSIDCOMMAND_H_DRIVE_DISTANCE 5.0
+
+// The lift stops this far (revolutions) short of the floor and the upper tower preset,
+// and never goes faster than _SYSIDCOMMAND_H_LIFT_SPEED (percent), so that holding it
+// can always catch it before it reaches either end.
+#define _SYSIDCOMMAND_H_LIFT_MARGIN 0.25
+#define _SYSIDCOMMAND_H_LIFT_SPEED 30
+
+// Longest a ramp or step test may run, in milliseconds, whatever the encoders say.
+#define _SYSIDCOMMAND_H_RAMP_TIMEOUT 12000
+#define _SYSIDCOMMAND_H_STEP_TIMEOUT 2500
+
+/**
+ * Runs one characterization test on the mechanism recorded by a `SysId`, and requires
+ * that mechanism.  The voltage is set every tick: rising at the ramp rate for the ramp
+ * tests, or fixed at the step voltage for the step tests.
+ *
+ * The lift needs a good part of its voltage just to hold itself up, so starting every
+ * test from 0V would drop it.  Only its upward ramp starts from 0V, and notes the
+ * voltage the lift breaks away at in `SysId::setHoldVoltage()`; the other tests ramp
+ * or step away from that voltage instead.
+ *
+ * The test stops the mechanism and finishes as soon as any of these happen, so it can
+ * be left to run on its own:
+ *  - the drive base has gone _SYSIDCOMMAND_H_DRIVE_DISTANCE from where it started;
+ *  - the lift is within _SYSIDCOMMAND_H_LIFT_MARGIN of the floor (going down) or the
+ *    upper tower preset (going up), or going faster than _SYSIDCOMMAND_H_LIFT_SPEED;
+ *  - the test has run for its timeout;
+ *  - the recorder is full.
+ * A test that starts out of range finishes straight away.
+ */
+class SysIdCommand : public Command {
+
+  public:
+
+    /**
+     * Creates a new instance of `SysIdCommand`.
+     *
+     * @param
+     *    sysid - The recorder for the mechanism to test.
+     *    test - Which test to run.
+     */
+    SysIdCommand(SysId* sysid, SysId::Test test);
+
+    void initialize() override;
+    void execute() override;
+    bool isFinished() override;
+    void end(bool interrupted) override;
+
+  private:
+
+    // Whether the mechanism has gone as far as it safely can in the test's direction.
+    bool outOfRange();
+
+    SysId* sysid;
+    SysId::Test test;
+    double direction;
+    double start;
+    timer elapsed;
+    bool done;
+};
+
+/**
+ * Builds the whole characterization of the mechanism recorded by `sysid` as a single
+ * command: each test in turn, waiting for the mechanism to come to rest in between.
+ * The drive base is characterized with the lift on the floor, since `setVoltage()`
+ * skips the lift-height limits.  Clears `sysid` first.
+ *
+ * Like `buildAutonomous()`, the commands come from pools sized for one copy of the
+ * routine.  Returns nullptr if the pools are exhausted or the routine could not be
+ * built.
+ */
+Command* buildCharacterization(SysId* sysid, RD4BLift* lift);
+
+#endif
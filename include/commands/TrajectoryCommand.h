@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "commands/Command.h"
+#include "subsystems/MecanumDriveTank.h"
+#include "Trajectory.h"
+
+#ifndef _TRAJECTORYCOMMAND_H_
+#define _TRAJECTORYCOMMAND_H_
+
+// The command finishes once every wheel is within this many revolutions of the end of
+// the trajectory, or at the latest _TRAJECTORYCOMMAND_H_SETTLE_TIME (milliseconds)
+// after the trajectory ends.
+#define _TRAJECTORYCOMMAND_H_TOLERANCE 0.05
+#define _TRAJECTORYCOMMAND_H_SETTLE_TIME 500
+
+/**
+ * A command that drives the mecanum base along a precomputed `Trajectory`, then
+ * brakes.  Requires the drive base.
+ *
+ * Each tick it looks up where the trajectory is at the time since the command started,
+ * interpolating between the table's points, and hands the wheel speeds and
+ * accelerations to `MecanumDriveTank::followWheels()` along with how far each wheel has
+ * fallen behind its planned position.  Nothing is worked out when the command starts
+ * beyond noting the encoders, so it can be scheduled straight away.
+ *
+ * The trajectory starts from wherever the robot is, so a wrong starting pose just
+ * carries through to the end rather than being corrected.
+ */
+class TrajectoryCommand : public Command {
+
+  public:
+
+    /**
+     * Creates a new instance of `TrajectoryCommand`.
+     *
+     * @param
+     *    drive - The drive base to move.
+     *    trajectory - The trajectory to follow; must outlive the command.
+     */
+    TrajectoryCommand(MecanumDriveTank* drive, const Trajectory* trajectory);
+
+    void initialize() override;
+    void execute() override;
+    bool isFinished() override;
+    void end(bool interrupted) override;
+
+    // Where the trajectory says the robot should be now.
+    const TrajectorySample& getTarget();
+
+  private:
+
+    MecanumDriveTank* drive;
+    const Trajectory* trajectory;
+
+    // Wheel encoders when the command started, and the sample for the current tick.
+    double start[4];
+    TrajectorySample target;
+    double errors[4];
+    timer elapsed;
+};
+
+#endif
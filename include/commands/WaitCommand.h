@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "commands/Command.h"
+
+#ifndef _WAITCOMMAND_H_
+#define _WAITCOMMAND_H_
+
+/**
+ * A command that does nothing for a fixed amount of time, then finishes.
+ * Unlike `task::sleep()`, this doesn't block the tick, so anything running in parallel
+ * with it keeps going.  Requires no subsystems.
+ */
+class WaitCommand : public Command {
+
+  public:
+
+    /**
+     * Creates a new instance of `WaitCommand`.
+     *
+     * @param
+     *    duration - How long to wait for, in milliseconds, starting from `initialize()`.
+     */
+    WaitCommand(uint32_t duration);
+
+    void initialize() override;
+    bool isFinished() override;
+
+  private:
+
+    uint32_t duration;
+    timer elapsed;
+};
+
+#endif
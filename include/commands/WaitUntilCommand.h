@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "commands/Command.h"
+
+#ifndef _WAITUNTILCOMMAND_H_
+#define _WAITUNTILCOMMAND_H_
+
+/**
+ * A command that does nothing until some condition becomes true, then finishes.
+ * Mostly useful inside a `SequentialGroup` to hold off the next step until a sensor
+ * says so.  Requires no subsystems.
+ */
+class WaitUntilCommand : public Command {
+
+  public:
+
+    /**
+     * Creates a new instance of `WaitUntilCommand`.
+     *
+     * @param
+     *    condition - A function that is checked once per tick; the command finishes the
+     *                first time it returns true.
+     */
+    WaitUntilCommand(Subsystem::ButtonInput condition);
+
+    bool isFinished() override;
+
+  private:
+
+    Subsystem::ButtonInput condition;
+};
+
+#endif
@@ -20,6 +20,7 @@
  * THE SOFTWARE.
  */
 
+#include "Tuned.h"
 #include "Subsystem.h"
 
 #ifndef _MDA_H_
@@ -32,7 +33,9 @@
 #define _MDA_H_CUBIC_TWIST true
 
 // Defines a ring around the center of the joystick where inputs are ignored
+#ifndef _MDA_H_DEADBAND
 #define _MDA_H_DEADBAND 5
+#endif
 
 /**
  * Defines a subsystem for controlling a Mecanum drive base.
@@ -78,13 +81,14 @@ class MecanumDriveArcade : public Subsystem {
      *             strafe, and twist axes, respectively.
      *    motors - An array of 4 vex::motor that represent the front-right, front-left,
      *             back-right, and back-left motors of the drive base, respectively.
+     *             Only their ports are used; the drive shares the handles in `Motors`.
      */
     MecanumDriveArcade(AxisInput inputs[3], motor motors[4]);
 
   private:
     // Internal variables for inputs and motors.
     AxisInput driveAxis, strafeAxis, twistAxis;
-    motor frontRight, frontLeft, backRight, backLeft;
+    motor &frontRight, &frontLeft, &backRight, &backLeft;
 };
 
 #endif
@@ -20,12 +20,75 @@
  * THE SOFTWARE.
  */
 
+#include "Tuned.h"
 #include "Subsystem.h"
 
 #ifndef _MDT_H_
 #define _MDT_H_
 
+#ifndef _MDT_H_DEADBAND
 #define _MDT_H_DEADBAND 5
+#endif
+
+// Wheel speed, in percent, below which the drive base is considered to be stopped.
+#define _MDT_H_STOPPED_VELOCITY 2
+
+// Lift height, in revolutions of the left lift motor, up to which the drive is never
+// limited, and the height at which the limits are tightest.
+#ifndef _MDT_H_SAFE_HEIGHT
+#define _MDT_H_SAFE_HEIGHT 0.25
+#endif
+#ifndef _MDT_H_TIP_HEIGHT
+#define _MDT_H_TIP_HEIGHT 2
+#endif
+
+// Largest change in wheel power per tick, and largest wheel power, in percent, with the
+// lift at or above _MDT_H_TIP_HEIGHT.
+#ifndef _MDT_H_TIP_ACCEL
+#define _MDT_H_TIP_ACCEL 5
+#endif
+#ifndef _MDT_H_TIP_SPEED
+#define _MDT_H_TIP_SPEED 60
+#endif
+
+// Feedforward model of one wheel, for `useFeedforward()`; see `Feedforward`.
+#ifndef _MDT_H_KS
+#define _MDT_H_KS 0
+#endif
+#ifndef _MDT_H_KV
+#define _MDT_H_KV 0.12
+#endif
+#ifndef _MDT_H_KA
+#define _MDT_H_KA 0.01
+#endif
+
+// Extra wheel speed, in percent per revolution of error, that `followWheels()` adds to
+// pull a wheel back onto its trajectory.
+#ifndef _MDT_H_FOLLOW_GAIN
+#define _MDT_H_FOLLOW_GAIN 100
+#endif
+
+// Slip ratio above which `useTractionControl()` treats a wheel as slipping.
+#ifndef _MDT_H_TRACTION_SLIP
+#define _MDT_H_TRACTION_SLIP 0.15
+#endif
+
+// Fastest the carpet can change the speed of a wheel's contact patch, in percent per
+// second.  A wheel speeding up or slowing down faster than this has broken loose.
+#ifndef _MDT_H_TRACTION_ACCEL
+#define _MDT_H_TRACTION_ACCEL 500
+#endif
+
+// Wheel and command speeds, in percent, below which slip isn't judged; at a crawl the
+// ratios are mostly encoder noise.
+#define _MDT_H_TRACTION_FLOOR 10
+
+// How much of a wheel's drive, beyond its ground speed, traction control takes away on
+// each tick it slips, the least it leaves, and how much it gives back on each tick it
+// grips.
+#define _MDT_H_TRACTION_CUT 0.25
+#define _MDT_H_TRACTION_MIN 0.25
+#define _MDT_H_TRACTION_RECOVER 0.1
 
 /**
  * Defines a subsystem for controlling a Mecanum drive base (Tank drive).
@@ -37,12 +100,18 @@ class MecanumDriveTank : public Subsystem {
 
   public:
 
+    // A function which returns the height of the lift, in revolutions.
+    typedef std::function<double()> HeightInput;
+
     /**
      * Let the mecanum drive base update with new input values.
      * This should be called once per tick for smooth control.
      */
     void update() override;
 
+    // Coast all four wheels, and zero their encoders.
+    void prepare() override;
+
     /**
      * Creates a new instance of the Mecanum Drive Tank subsystem.
      *
@@ -72,15 +141,144 @@ class MecanumDriveTank : public Subsystem {
      *             right drive, and strafe axes, respectively.
      *    motors - An array of 4 vex::motor that represent the front-right, front-left,
      *             back-right, and back-left motors of the drive base, respectively.
+     *             Only their ports are used; the drive shares the handles in `Motors`.
      */
     MecanumDriveTank(AxisInput inputs[3], motor motors[4]);
 
+    /**
+     * Drive the base directly, bypassing the joystick inputs.  Used by commands, which
+     * take over the drive base from `update()` while they run.
+     *
+     * @param
+     *    forward - Forward/backward power, -100...100.  Positive is forwards.
+     *    strafe - Sideways power, -100...100, in the same direction as the strafe axis.
+     *    turn - Turning power, -100...100.  Positive is clockwise.
+     */
+    void drive(int32_t forward, int32_t strafe, int32_t turn);
+
+    /**
+     * Stop all four motors with the given brake mode.
+     */
+    void stop(brakeType mode);
+
+    /**
+     * Returns the distance driven forwards since the last call to `resetDistance()`,
+     * as the average of the four wheel encoders in revolutions.
+     */
+    double getDistance();
+
+    /**
+     * Zero the distance returned by `getDistance()`.
+     */
+    void resetDistance();
+
+    /**
+     * Returns true if none of the four wheels are turning faster than
+     * _MDT_H_STOPPED_VELOCITY.
+     */
+    bool isStopped();
+
+    /**
+     * Drive straight forwards with `volts` (reference volts, see `Compensation`) on
+     * every wheel, bypassing the mixer, the feedforward model and the lift-height
+     * limits.  Only for characterizing the drive base, with the lift down.
+     */
+    void setVoltage(double volts);
+
+    /**
+     * Returns the forwards speed of the drive base, as the average of the four wheel
+     * speeds in percent.  Same sign as `getDistance()`.
+     */
+    double getSpeed();
+
+    /**
+     * Returns the position of each wheel, in revolutions, in the order front-left,
+     * front-right, back-left, back-right and in each motor's own direction.
+     */
+    void getWheelPositions(double positions[4]);
+
+    /**
+     * Drive each wheel at its own speed, for following a `Trajectory`.  Each wheel gets
+     * the voltage the feedforward model says it needs for its speed and acceleration,
+     * plus `Config::followGain` percent of speed for every revolution it is behind.
+     * Bypasses the mixer and the lift-height limits, which the trajectory has to
+     * respect itself.
+     *
+     * @param
+     *    speeds - Wheel speeds, in percent, in the order of `getWheelPositions()`.
+     *    accelerations - Wheel accelerations, in percent per second.
+     *    errors - How far each wheel is behind where it should be, in revolutions.
+     */
+    void followWheels(const double speeds[4], const double accelerations[4], const double errors[4]);
+
+    /**
+     * Limit the acceleration and top speed of the drive base by the height of the lift,
+     * so that it can't tip the robot over.  The limits are looked up from
+     * `Config::driveLimits` each tick, and apply to commands as well as the driver.
+     * Without a height input, the drive base is never limited.
+     */
+    void setLiftHeight(HeightInput height);
+
+    /**
+     * Hold back wheels that slip.  Each tick, every wheel's measured speed is compared
+     * against the ground speed the commanded motion implies for it, and a wheel that
+     * is spinning away from it gets less drive until it grips again.  The other wheels
+     * take up what it loses, as far as they can without changing the motion asked for.
+     * Applies to the sticks and `drive()`; trajectories are planned within the
+     * traction limits already, and only have their slip measured.
+     */
+    void useTractionControl(bool enabled);
+
+    /**
+     * Returns the slip ratio of each wheel on the last tick, in the order of
+     * `getWheelPositions()`: how much faster (positive) or slower than its ground
+     * speed the wheel was turning, as a fraction of its speed.  Zero while traction
+     * control is off.
+     */
+    void getSlip(double slip[4]);
+
   private:
 
+    /**
+     * Mix drive, twist and strafe powers into the four wheel speeds, normalize them, and
+     * set them on the motors.  Shared by `update()` and `drive()`.
+     */
+    void setMotorPowers(int32_t drivePower, int32_t twistPower, int32_t strafePower);
+
+    /**
+     * Estimate each wheel's ground speed and slip from its measured speed and the
+     * wheel speeds just commanded (`powers`, in the order of `getWheelPositions()`).
+     * Reads each wheel once and does a fixed amount of arithmetic, so it costs the
+     * same every tick.
+     */
+    void measureSlip(const double powers[4], double dt);
+
+    /**
+     * Take drive away from slipping wheels in `volts` and move it to the others, then
+     * update how much drive each wheel is allowed.  Call after `measureSlip()`.
+     */
+    void limitSlip(double volts[4]);
+
     // Internal variables for inputs and motors.
     AxisInput lDriveAxis, rDriveAxis, strafeAxis;
     ButtonInput halfDrive;
-    motor frontRight, frontLeft, backRight, backLeft;
+    HeightInput liftHeight;
+    motor &frontRight, &frontLeft, &backRight, &backLeft;
+
+    // Wheel powers set on the last tick, in the order front-left, front-right,
+    // back-left, back-right, for limiting the acceleration.
+    int32_t lastPowers[4];
+
+    // Reference speed of each wheel, in the same order, for feedforward output.
+    double references[4];
+
+    // Traction control, per wheel in the same order: estimated ground speed (percent),
+    // slip ratio on the last tick, and the share of drive beyond the ground speed that
+    // the wheel is allowed (1 while it grips).
+    bool traction;
+    double groundSpeeds[4];
+    double slips[4];
+    double shares[4];
 
 };
 
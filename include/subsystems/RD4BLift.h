@@ -20,6 +20,7 @@
  * THE SOFTWARE.
  */
 
+#include "Tuned.h"
 #include "Subsystem.h"
 
 #ifndef _RD4BLIFT_H_
@@ -28,16 +29,93 @@
 /**
  * Defines a deadband for the lift, a zone in which small inputs will be ignored
  */
+#ifndef _RD4BLIFT_H_DBAND
 #define _RD4BLIFT_H_DBAND 5
+#endif
 
 /*
- * Defines encoder values, measured in raw units, of the min/max positions of the lift,
- * the lower tower, and the upper tower.  These may need to be tuned periodically.
+ * Defines the top of the lift's travel, and the floor, lower tower and upper tower
+ * positions, all in revolutions of the left motor.  These may need to be tuned
+ * periodically.
  */
-#define _RD4BLIFT_H_MAX_HEIGHT 10000
+#ifndef _RD4BLIFT_H_MAX_HEIGHT
+#define _RD4BLIFT_H_MAX_HEIGHT 2.2
+#endif
+#ifndef _RD4BLIFT_H_FLOOR
 #define _RD4BLIFT_H_FLOOR 0
+#endif
+#ifndef _RD4BLIFT_H_LOWER_TOWER
 #define _RD4BLIFT_H_LOWER_TOWER 1
+#endif
+#ifndef _RD4BLIFT_H_UPPER_TOWER
 #define _RD4BLIFT_H_UPPER_TOWER 2
+#endif
+
+/**
+ * Defines how close, in revolutions, the lift has to be to a preset height for it to
+ * count as having reached it.
+ */
+#ifndef _RD4BLIFT_H_TOLERANCE
+#define _RD4BLIFT_H_TOLERANCE 0.05
+#endif
+
+/**
+ * Defines the speed, in percent, that the lift moves between preset heights at.
+ */
+#ifndef _RD4BLIFT_H_PRESET_SPEED
+#define _RD4BLIFT_H_PRESET_SPEED 50
+#endif
+
+/**
+ * Defines how hard the lift may be slowed down, in percent of free speed per second,
+ * as it comes up to either end of its travel.  See `getSpeedLimit()`.
+ */
+#ifndef _RD4BLIFT_H_STOP_DECEL
+#define _RD4BLIFT_H_STOP_DECEL 400
+#endif
+
+/**
+ * Defines the share of `_RD4BLIFT_H_STOP_DECEL` the lift gets going down, where gravity
+ * is against the motors slowing it.
+ */
+#define _RD4BLIFT_H_DOWN_DECEL 0.5
+
+/**
+ * Defines the free speed of the lift motors (green cartridges), in revolutions per
+ * second, for turning speeds in percent into distances.
+ */
+#define _RD4BLIFT_H_FREE_SPEED (200.0 / 60)
+
+/**
+ * Defines how far short of either end, in revolutions, the lift is meant to have
+ * slowed down by, to allow for it lagging behind the envelope.
+ */
+#ifndef _RD4BLIFT_H_STOP_MARGIN
+#define _RD4BLIFT_H_STOP_MARGIN 0.03
+#endif
+
+/**
+ * Defines the speed, in percent, the lift is always allowed towards an end of its
+ * travel it hasn't reached yet, so that it can get all the way there.
+ */
+#define _RD4BLIFT_H_CREEP_SPEED 10
+
+/**
+ * Defines the feedforward model of the lift for manual control with
+ * `useFeedforward()`; see `Feedforward`.
+ */
+#ifndef _RD4BLIFT_H_KS
+#define _RD4BLIFT_H_KS 0
+#endif
+#ifndef _RD4BLIFT_H_KV
+#define _RD4BLIFT_H_KV 0.12
+#endif
+#ifndef _RD4BLIFT_H_KA
+#define _RD4BLIFT_H_KA 0
+#endif
+#ifndef _RD4BLIFT_H_KG
+#define _RD4BLIFT_H_KG 0
+#endif
 
 /**
  * Defines a subsystem for controlling an RD4B lift.
@@ -50,12 +128,17 @@
  *  - State::LOWER_TOWER = `RD4BLift` position is held to the lower tower height by encoder.
  *  - State::UPPER_TOWER = `RD4BLift` position is held to the upper tower height by encoder.
  *
+ * Every constant used at runtime is read from the subsystem's `Config` (see `Config.h`);
+ * the definitions above are only the compiled-in defaults.
+ *
  * As a safety feature, State::MANUAL always take precedence over the other automated states;
  * i.e. automated movements can always be immediately cancelled, even when not yet completed,
  * by any manual input to the axis.
  *
- * State::MANUAL also includes additional safety measures that ensure the lift is never
- * extended beyond its intended range of motion.
+ * In every state, the lift is kept inside a speed envelope: full speed mid-travel,
+ * slowing down smoothly as it comes up to the floor or the top of its travel so that
+ * it stops there instead of slamming into the hard stop, and full speed again the
+ * moment it heads away.  See `getSpeedLimit()`.
  *
  * @author Brandon Gong
  * @date 10-26-19
@@ -64,12 +147,25 @@ class RD4BLift : public Subsystem {
 
   public:
 
+    /**
+     * Defines possible States that `RD4BLift` can be in.
+     */
+    enum State {
+      MANUAL,       // Manual control via axis input
+      GROUND,       // Held at ground level
+      LOWER_TOWER,  // Held at lower tower level
+      UPPER_TOWER   // Held at upper tower level
+    };
+
     /**
      * Let the RD4B lift update with new input values.
      * This *must* be called once per tick.  The robot can and will be damaged otherwise.
      */
     void update() override;
 
+    // Zero both lift encoders at the current (floor) position, and brake the motors.
+    void prepare() override;
+
     /**
      * Creates a new instance of `RD4BLift`, without any button inputs.
      * This will essentially disable all states besides State::MANUAL.
@@ -101,31 +197,87 @@ class RD4BLift : public Subsystem {
               int32_t leftMotorPort,
               int32_t rightMotorPort );
 
-  private:
+    /**
+     * Switch the lift to a new state.  Manual input will still override this on the
+     * next `update()`, but not while a command is driving the lift through `runState()`.
+     */
+    void setState(State state);
+
+    // Returns the current state of the lift.
+    State getState();
 
     /**
-     * Defines possible States that `RD4BLift` can be in.
+     * Run the function for the current state without reading any input.  Used by
+     * commands, which take over the lift from `update()` while they run.
      */
-    enum State {
-      MANUAL,       // Manual control via axis input
-      GROUND,       // Held at ground level
-      LOWER_TOWER,  // Held at lower tower level
-      UPPER_TOWER   // Held at upper tower level
-    };
+    void runState();
+
+    // Returns the height of the lift, in revolutions of the left motor from the floor.
+    double getHeight();
+
+    /**
+     * Returns true if the lift is within _RD4BLIFT_H_TOLERANCE of the height held by the
+     * current state.  Always true in State::MANUAL, which has no target height.
+     */
+    bool atTarget();
+
+    /**
+     * Drive both motors with `volts` (reference volts, see `Compensation`), positive
+     * being up, bypassing the state and the feedforward model.  Only for
+     * characterizing the lift.
+     */
+    void setVoltage(double volts);
+
+    // Stop both motors with the given brake mode.
+    void stop(brakeType mode);
+
+    // Returns the speed of the lift in percent of the left motor's free speed.  Positive is up.
+    double getSpeed();
+
+    /**
+     * Returns the fastest the lift may go, in percent, up (`up` true) or down from
+     * `height`, for it to still stop before that end of its travel when slowed at
+     * `Config::liftStopDecel`.  Zero at or past that end.
+     */
+    double getSpeedLimit(double height, bool up);
+
+    /**
+     * Keep the lift inside the speed envelope (on by default).  Only for tools that
+     * measure what the envelope does.
+     */
+    void useSoftLimits(bool enabled);
+
+  private:
 
     // Current state of this `RD4BLift` instance.
     State state;
 
+    // Whether the preset in `state` had been reached as of the last tick.
+    bool reached;
+
+    // Reference speed for feedforward output in manual control.
+    double reference;
+
+    // Whether the speed envelope is on.
+    bool softLimits;
+
     // Functions that correspond to a certain state, and are called by update() based on state.
     void stateManual();     // State::MANUAL
     void stateGround();     // State::GROUND
     void stateLowerTower(); // State::LOWER_TOWER
     void stateUpperTower(); // State::UPPER_TOWER
 
+    // Start both motors towards the given height, in revolutions of the left motor.
+    void moveTo(double height);
+
+    // Where the lift at `height` will be in `dt` seconds going at `speed` percent, in
+    // revolutions.
+    double getHeightAhead(double height, double speed, double dt);
+
     // Internal variables for storing all of the functions for obtaining user input and the two motors.
     AxisInput manualInput;
     ButtonInput groundInput, lowerTowerInput, upperTowerInput;
-    motor liftMotor0, liftMotor1;
+    motor &liftMotor0, &liftMotor1;
 };
 
 #endif
@@ -20,12 +20,31 @@
  * THE SOFTWARE.
  */
 
+#include "Tuned.h"
 #include "Subsystem.h"
 
 #ifndef _ROLLER_H_
 #define _ROLLER_H_
 
+#ifndef _ROLLER_H_POWER
 #define _ROLLER_H_POWER 75
+#endif
+
+// Feedforward model of one roller, for `useFeedforward()`; see `Feedforward`.
+#ifndef _ROLLER_H_KS
+#define _ROLLER_H_KS 0
+#endif
+#ifndef _ROLLER_H_KV
+#define _ROLLER_H_KV 0.12
+#endif
+#ifndef _ROLLER_H_KA
+#define _ROLLER_H_KA 0
+#endif
+
+// The rollers count as jammed once they have been powered but turning slower than
+// _ROLLER_H_JAM_SPEED (percent) for _ROLLER_H_JAM_TICKS ticks in a row.
+#define _ROLLER_H_JAM_SPEED 5
+#define _ROLLER_H_JAM_TICKS 10
 
 /**
  * Defines a subsystem for controlling a roller intake.
@@ -45,6 +64,9 @@ class RollerIntake : public Subsystem {
      */
     void update() override;
 
+    // Set both rollers to hold when stopped, so a cube can't push them round.
+    void prepare() override;
+
     /**
      * Create a new instance of roller intake.
      */
@@ -53,10 +75,33 @@ class RollerIntake : public Subsystem {
                   int32_t leftMotorPort,
                   int32_t rightMotorPort );
 
+    /**
+     * Spin the rollers at the given power, bypassing the button inputs.  Used by
+     * commands, which take over the intake from `update()` while they run.
+     *
+     * @param
+     *    power - Roller power, -100...100.  Positive is the same direction as `inInput`.
+     */
+    void spin(int32_t power);
+
+    // Whether the rollers are powered but stuck, e.g. on a cube caught sideways.
+    bool isJammed();
+
+    // Speed of the rollers in percent, and how far they have turned in revolutions.
+    // Positive is the same direction as `inInput`.
+    double getSpeed();
+    double getRotation();
+
   private:
 
+    // Ticks in a row the rollers have been powered but not turning.
+    int32_t stalledTicks;
+
+    // Reference speed for feedforward output.
+    double reference;
+
     ButtonInput inInput, outInput;
-    motor left, right;
+    motor &left, &right;
 
 };
 
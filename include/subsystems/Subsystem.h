@@ -21,7 +21,10 @@
  */
 
 #include "vex.h"
+#include "Config.h"
+#include "Compensation.h"
 #include <functional>
+#include <math.h>
 
 #ifndef _SUBSYSTEM_H_
 #define _SUBSYSTEM_H_
@@ -46,6 +49,93 @@ class Subsystem {
     // The `update()` function must be defined for all subsystems
     virtual void update() = 0;
 
+    /**
+     * Get the hardware ready before the first `update()`: zero encoders, set brake
+     * modes, and so on.  Constructors leave the motors alone, so that the robot can
+     * prepare every subsystem at once (see `Startup`).  A subsystem's `prepare()` only
+     * touches its own devices, so it is safe to run alongside the others.
+     */
+    virtual void prepare() {}
+
+    /**
+     * Point this subsystem at a different set of tuning constants.  By default every
+     * subsystem uses `activeConfig`.  The `Config` is not copied, so it must outlive
+     * the subsystem.
+     */
+    void configure(const Config* config) { this->config = config; }
+
+    // The tuning constants this subsystem is using.
+    const Config* getConfig() const { return this->config; }
+
+    /**
+     * Drive this subsystem's motors through its `Feedforward` model instead of their
+     * own velocity loops.  With it off (the default), a power is a velocity in percent
+     * for the motor to hold by itself.  With it on, a power is a target
+     * speed: a reference speed chases the target as fast as the model says the
+     * motor can accelerate, and the model's voltage for the reference drives the
+     * motor, so it gets to the target at full voltage and settles there without
+     * overshooting.
+     */
+    void useFeedforward(bool enabled) { this->feedforward = enabled; }
+
+  protected:
+
+    Subsystem() : config(&activeConfig), feedforward(false), lastOutput(0) {}
+
+    /**
+     * Returns the voltage to command for `power` percent, and moves that motor's
+     * reference speed `dt` seconds on towards it.  See `useFeedforward()`.
+     */
+    double outputVolts(const Feedforward& model, double power, double& reference, double dt) const {
+      if(!this->feedforward || model.kA <= 0) {
+        reference = power;
+        return this->feedforward ? model.volts(power, 0) : power * _COMPENSATION_H_FULL_SCALE / 100;
+      }
+      // Whatever voltage holding the reference speed leaves over goes into accelerating.
+      double headroom = _COMPENSATION_H_FULL_SCALE - fabs(model.volts(reference, 0));
+      if(headroom < _COMPENSATION_H_FULL_SCALE / 10) headroom = _COMPENSATION_H_FULL_SCALE / 10;
+      double limit = headroom / model.kA;
+      double acceleration = (power - reference) / dt;
+      if(acceleration > limit) acceleration = limit;
+      if(acceleration < -limit) acceleration = -limit;
+      reference += acceleration * dt;
+      return model.volts(reference, acceleration);
+    }
+
+    /**
+     * Spin `m` with an output from `outputVolts()`.  With feedforward on, that is a
+     * voltage, compensated for the battery.  With it off, it is sent as the same
+     * fraction of full speed to the motor's velocity loop, which needs no compensation.
+     */
+    void spinOutput(motor& m, double volts) const {
+      if(this->feedforward) {
+        batteryCompensation.spinVolts(m, volts);
+      } else {
+        m.spin(directionType::fwd, volts * 100 / _COMPENSATION_H_FULL_SCALE, velocityUnits::pct);
+      }
+    }
+
+    /**
+     * Returns the seconds since the last call, for working out accelerations.  Kept
+     * between 1ms and 100ms, so the first call and any long gap don't look like a
+     * huge or tiny acceleration.
+     */
+    double outputInterval() {
+      uint64_t now = timer::systemHighResolution();
+      double dt = (now - this->lastOutput) * 1e-6;
+      this->lastOutput = now;
+      return dt < 0.001 ? 0.001 : dt > 0.1 ? 0.1 : dt;
+    }
+
+    // Tuning constants for this subsystem.
+    const Config* config;
+
+    bool feedforward;
+
+  private:
+
+    uint64_t lastOutput;
+
 };
 
 #endif
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Autonomous.h"
+#include "commands/CommandPool.h"
+#include "commands/CommandGroup.h"
+#include "commands/TrajectoryCommand.h"
+#include "commands/LiftCommand.h"
+#include "commands/IntakeCommand.h"
+#include "Trajectories.h"
+
+// Storage for every command in the routine below.  Keep these in sync with it.
+static CommandPool<TrajectoryCommand, 4> trajectoryPool;
+static CommandPool<LiftCommand, 1> liftPool;
+static CommandPool<IntakeCommand, 1> intakePool;
+static CommandPool<SequentialGroup, 1> sequentialPool;
+static CommandPool<ParallelGroup, 1> parallelPool;
+static CommandPool<RaceGroup, 1> racePool;
+
+/*
+ * Same moves as the old timed routine.  Distances were worked out from the old timings
+ * at 200rpm (e.g. 50% for 2 seconds is about 3.3 revolutions), so they may need tuning.
+ * The drive moves are trajectories planned from host/autonomous.route.
+ *
+ *  1. Back up while lowering the lift to the floor, so it is down before we reach the cubes.
+ *  2. Creep forwards with the rollers running; the rollers stop as soon as the drive does.
+ *  3. Back up, then drive forwards into the scoring zone.  Each trajectory ends at rest,
+ *     so there is no need to wait for the drive base to stop in between.
+ */
+Command* buildAutonomous(MecanumDriveTank* drive, RD4BLift* lift, RollerIntake* intake) {
+  SequentialGroup* routine = sequentialPool.acquire();
+  ParallelGroup* backUpAndLower = parallelPool.acquire();
+  RaceGroup* collect = racePool.acquire();
+  if(routine == nullptr || backUpAndLower == nullptr || collect == nullptr) {
+    if(routine != nullptr) routine->release();
+    if(backUpAndLower != nullptr) backUpAndLower->release();
+    if(collect != nullptr) collect->release();
+    return nullptr;
+  }
+
+  // Every add() runs even after one fails, so that each command ends up owned by the
+  // routine and releasing the routine hands all of them back to their pools.
+  bool built = backUpAndLower->add(trajectoryPool.acquire(drive, &BACK_UP));
+  built = backUpAndLower->add(liftPool.acquire(lift, RD4BLift::State::GROUND)) && built;
+
+  built = collect->add(trajectoryPool.acquire(drive, &COLLECT)) && built;
+  built = collect->add(intakePool.acquire(intake, -50)) && built;
+
+  built = routine->add(backUpAndLower) && built;
+  built = routine->add(collect) && built;
+  built = routine->add(trajectoryPool.acquire(drive, &BACK_OFF)) && built;
+  built = routine->add(trajectoryPool.acquire(drive, &SCORE)) && built;
+
+  if(!built) {
+    routine->release();
+    return nullptr;
+  }
+  return routine;
+}
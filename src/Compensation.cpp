@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Compensation.h"
+
+Compensation batteryCompensation;
+
+Compensation::Compensation() : factor(1) {}
+
+void Compensation::setBatteryVoltage(double volts) {
+  double factor = volts > 0 ? _COMPENSATION_H_REFERENCE / volts : 1;
+  if(factor < _COMPENSATION_H_MIN_FACTOR) factor = _COMPENSATION_H_MIN_FACTOR;
+  if(factor > _COMPENSATION_H_MAX_FACTOR) factor = _COMPENSATION_H_MAX_FACTOR;
+  this->factor.store((float) factor);
+}
+
+double Compensation::getFactor() const {
+  return this->factor.load();
+}
+
+// Anything past full scale would only be clipped by the motor, so clip it here.
+double Compensation::toVolts(double percent) const {
+  double volts = percent * this->factor.load() * _COMPENSATION_H_FULL_SCALE / 100;
+  if(volts > _COMPENSATION_H_FULL_SCALE) volts = _COMPENSATION_H_FULL_SCALE;
+  if(volts < -_COMPENSATION_H_FULL_SCALE) volts = -_COMPENSATION_H_FULL_SCALE;
+  return volts;
+}
+
+void Compensation::spinVolts(motor& m, double volts) const {
+  m.spin(directionType::fwd, this->toVolts(volts * 100 / _COMPENSATION_H_FULL_SCALE), voltageUnits::volt);
+}
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// Tuned.h goes first so that whatever it defines wins over the subsystem defaults.
+#include "Tuned.h"
+#include "Config.h"
+#include "subsystems/MecanumDriveArcade.h"
+#include "subsystems/MecanumDriveTank.h"
+#include "subsystems/RD4BLift.h"
+#include "subsystems/RollerIntake.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+// The drive limits divide by these, so a Tuned.h that zeroes them must not build.
+static_assert(_MDT_H_TIP_ACCEL > 0, "_MDT_H_TIP_ACCEL must be at least 1");
+static_assert(_MDT_H_TIP_SPEED > 0, "_MDT_H_TIP_SPEED must be at least 1");
+
+Config activeConfig;
+
+Config::Config() {
+  this->driveDeadband = _MDT_H_DEADBAND;
+  this->arcadeDeadband = _MDA_H_DEADBAND;
+  this->liftDeadband = _RD4BLIFT_H_DBAND;
+  this->liftFloor = _RD4BLIFT_H_FLOOR;
+  this->liftLowerTower = _RD4BLIFT_H_LOWER_TOWER;
+  this->liftUpperTower = _RD4BLIFT_H_UPPER_TOWER;
+  this->liftTolerance = _RD4BLIFT_H_TOLERANCE;
+  this->liftMaxHeight = _RD4BLIFT_H_MAX_HEIGHT;
+  this->liftStopDecel = _RD4BLIFT_H_STOP_DECEL;
+  this->liftPresetSpeed = _RD4BLIFT_H_PRESET_SPEED;
+  this->rollerPower = _ROLLER_H_POWER;
+  this->liftSafeHeight = _MDT_H_SAFE_HEIGHT;
+  this->liftTipHeight = _MDT_H_TIP_HEIGHT;
+  this->tipAccel = _MDT_H_TIP_ACCEL;
+  this->tipSpeed = _MDT_H_TIP_SPEED;
+  this->followGain = _MDT_H_FOLLOW_GAIN;
+  this->tractionSlip = _MDT_H_TRACTION_SLIP;
+  this->tractionAccel = _MDT_H_TRACTION_ACCEL;
+  this->driveModel = { _MDT_H_KS, _MDT_H_KV, _MDT_H_KA, 0 };
+  this->liftModel = { _RD4BLIFT_H_KS, _RD4BLIFT_H_KV, _RD4BLIFT_H_KA, _RD4BLIFT_H_KG };
+  this->rollerModel = { _ROLLER_H_KS, _ROLLER_H_KV, _ROLLER_H_KA, 0 };
+  this->buildDriveLimits();
+}
+
+/*
+ * Step i covers heights from i to i + 1 steps up, and takes the limits at the top of
+ * that range so that the robot is never driven harder than its height allows.
+ *
+ * The acceleration that tips the robot goes as one over the height of its centre of
+ * mass, which rises about linearly with the lift, so the acceleration limit is
+ * interpolated in 1 / accel rather than straight.
+ */
+void Config::buildDriveLimits() {
+  double step = this->liftTipHeight / _CONFIG_H_DRIVE_STEPS;
+  double range = this->liftTipHeight - this->liftSafeHeight;
+  for(int32_t i = 0; i < _CONFIG_H_DRIVE_STEPS; i++) {
+    double top = (i + 1) * step;
+    double t = range > 0 ? (top - this->liftSafeHeight) / range : 1;
+    if(t < 0) t = 0;
+    if(t > 1) t = 1;
+    this->driveLimits[i].accel = (int32_t) (1 / (0.01 + t * (1.0 / this->tipAccel - 0.01)));
+    this->driveLimits[i].speed = (int32_t) (100 + t * (this->tipSpeed - 100));
+  }
+}
+
+const DriveLimit& Config::driveLimit(double height) const {
+  int32_t i = this->liftTipHeight > 0
+            ? (int32_t) (height * _CONFIG_H_DRIVE_STEPS / this->liftTipHeight)
+            : _CONFIG_H_DRIVE_STEPS - 1;
+  if(i < 0) i = 0;
+  if(i >= _CONFIG_H_DRIVE_STEPS) i = _CONFIG_H_DRIVE_STEPS - 1;
+  return this->driveLimits[i];
+}
+
+// Where each field lives in the struct, so that every line of the file is matched by
+// name against this one table instead of a hand-written chain of ifs.  A value outside
+// `min`...`max` leaves the field at its default; the ranges are wide, and only there to
+// catch typos and values that would break the maths (e.g. a tipAccel of 0).
+struct ConfigField {
+  const char* name;
+  bool integer;
+  size_t offset;
+  double min;
+  double max;
+};
+
+#define INT_FIELD(x, min, max)    { #x, true,  offsetof(Config, x), min, max }
+#define DOUBLE_FIELD(x, min, max) { #x, false, offsetof(Config, x), min, max }
+
+static const ConfigField fields[] = {
+  INT_FIELD(driveDeadband, 0, 50),
+  INT_FIELD(arcadeDeadband, 0, 50),
+  INT_FIELD(liftDeadband, 0, 50),
+  DOUBLE_FIELD(liftFloor, 0, 10),
+  DOUBLE_FIELD(liftLowerTower, 0, 10),
+  DOUBLE_FIELD(liftUpperTower, 0, 10),
+  DOUBLE_FIELD(liftTolerance, 0.001, 1),
+  DOUBLE_FIELD(liftMaxHeight, 0.1, 10),
+  DOUBLE_FIELD(liftStopDecel, 1, 10000),
+  INT_FIELD(liftPresetSpeed, 1, 100),
+  INT_FIELD(rollerPower, 1, 100),
+  DOUBLE_FIELD(liftSafeHeight, 0, 10),
+  DOUBLE_FIELD(liftTipHeight, 0.1, 10),
+  INT_FIELD(tipAccel, 1, 100),
+  INT_FIELD(tipSpeed, 1, 100),
+  DOUBLE_FIELD(followGain, 0, 1000),
+  DOUBLE_FIELD(tractionSlip, 0.01, 1),
+  DOUBLE_FIELD(tractionAccel, 1, 10000),
+  DOUBLE_FIELD(driveModel.kS, 0, 12),
+  DOUBLE_FIELD(driveModel.kV, 0, 1),
+  DOUBLE_FIELD(driveModel.kA, 0, 1),
+  DOUBLE_FIELD(liftModel.kS, 0, 12),
+  DOUBLE_FIELD(liftModel.kV, 0, 1),
+  DOUBLE_FIELD(liftModel.kA, 0, 1),
+  DOUBLE_FIELD(liftModel.kG, -12, 12),
+  DOUBLE_FIELD(rollerModel.kS, 0, 12),
+  DOUBLE_FIELD(rollerModel.kV, 0, 1),
+  DOUBLE_FIELD(rollerModel.kA, 0, 1),
+};
+
+// The file is read into here rather than onto the heap or the stack.
+static char fileBuffer[_CONFIG_H_MAX_SIZE + 1];
+
+int32_t Config::load(const char* name) {
+  vex::brain::sdcard card;
+  if(!card.isInserted()) return -1;
+  int32_t length = card.loadfile(name, (uint8_t*) fileBuffer, _CONFIG_H_MAX_SIZE);
+  if(length <= 0) return -1;
+  fileBuffer[length] = '\0';
+
+  // Start again from the defaults, so that removing a line from the file undoes it.
+  Config loaded;
+  int32_t count = 0;
+
+  for(char* line = fileBuffer; line != nullptr; ) {
+    char* end = strchr(line, '\n');
+    if(end != nullptr) *end = '\0';
+
+    // Comments may be indented too.
+    while(*line == ' ' || *line == '\t') line++;
+    char* equals = strchr(line, '=');
+    if(line[0] != '#' && equals != nullptr) {
+      // Trim the name on the right; the left was trimmed above.
+      char* key = line;
+      char* keyEnd = equals;
+      while(keyEnd > key && (keyEnd[-1] == ' ' || keyEnd[-1] == '\t')) keyEnd--;
+      *keyEnd = '\0';
+
+      const ConfigField* field = nullptr;
+      for(const ConfigField& candidate : fields) {
+        if(strcmp(candidate.name, key) == 0) field = &candidate;
+      }
+      char* valueEnd;
+      double value = strtod(equals + 1, &valueEnd);
+      if(field == nullptr) {
+        printf("config: unknown key %s\n", key);
+      } else if(valueEnd == equals + 1 || !(value >= field->min && value <= field->max)) {
+        // Written so that NaN fails too.
+        printf("config: %s must be %g to %g, using the default\n", key, field->min, field->max);
+      } else {
+        char* target = (char*) &loaded + field->offset;
+        if(field->integer) *(int32_t*) target = (int32_t) value;
+        else *(double*) target = value;
+        count++;
+      }
+    }
+
+    line = end == nullptr ? nullptr : end + 1;
+  }
+
+  loaded.buildDriveLimits();
+  *this = loaded;
+  return count;
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Dashboard.h"
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+
+using namespace vex;
+
+// Height of one row of text, in pixels, on the live page and the statistics page.
+#define ROW 30
+#define STATS_ROW 22
+
+static const char* stateNames[] = { "MANUAL", "GROUND", "LOWER TOWER", "UPPER TOWER" };
+
+Dashboard::Dashboard() {
+  this->liftWidget    = { 10, 1 * ROW, 24, 0, false };
+  this->batteryWidget = { 10, 2 * ROW, 32, 0, false };
+  this->loopWidget    = { 10, 3 * ROW, 40, 0, false };
+  // Motor temperatures in two columns of four.
+  for(int i = 0; i < _ROBOTSTATE_H_MOTORS; i++) {
+    this->motorWidgets[i] = { 10 + (i % 2) * 240, (5 + i / 2) * ROW, 16, 0, false };
+  }
+  this->cleared = false;
+  this->statsShown = false;
+}
+
+void Dashboard::start() {
+  task(Dashboard::run, this, task::taskPrioritylow);
+}
+
+int Dashboard::run(void* dashboard) {
+  while(true) {
+    ((Dashboard*) dashboard)->draw();
+    task::sleep(_DASHBOARD_H_FRAME_TIME);
+  }
+  return 0;
+}
+
+bool Dashboard::show(Widget& widget, int32_t value, const char* format, ...) {
+  if(widget.drawn && widget.shown == value) return false;
+
+  char text[48];
+  va_list args;
+  va_start(args, format);
+  vsnprintf(text, sizeof(text), format, args);
+  va_end(args);
+
+  // Pad with spaces to the widget's width, which paints over whatever was there before.
+  this->brain.Screen.printAt(widget.x, widget.y, "%-*s", (int) widget.width, text);
+  widget.shown = value;
+  widget.drawn = true;
+  return true;
+}
+
+/*
+ * While paused, the widgets keep whatever they last showed, so nothing needs to be
+ * redrawn when drawing starts again.  Coming back from the statistics page, though,
+ * the screen has to be cleared and every widget drawn again.
+ */
+int32_t Dashboard::draw() {
+  ControlState control;
+  SensorState sensors;
+  if(!controlState.read(control) || !sensorState.read(sensors)) return 0;
+  if(control.watchdogLevel != Watchdog::Level::NORMAL) return 0;
+
+  MotorStats stats;
+  if(!control.enabled && motorStats.read(stats) && !stats.running && stats.time > 0) {
+    if(this->statsShown) return 0;
+    this->drawStats(stats);
+    this->statsShown = true;
+    this->cleared = false;
+    return 1;
+  }
+  this->statsShown = false;
+
+  if(!this->cleared) {
+    this->brain.Screen.setFillColor(color::black);
+    this->brain.Screen.setPenColor(color::white);
+    this->brain.Screen.clearScreen();
+    this->brain.Screen.printAt(10, 4 * ROW + ROW / 2, "Motor temperatures");
+    this->liftWidget.drawn = this->batteryWidget.drawn = this->loopWidget.drawn = false;
+    for(Widget& widget : this->motorWidgets) widget.drawn = false;
+    this->cleared = true;
+  }
+
+  int32_t redrawn = 0;
+
+  redrawn += this->show(this->liftWidget, control.liftState, "Lift: %s", stateNames[control.liftState]);
+
+  // Shown to 0.1V and the compensation to 0.01; the widget changes when any number does.
+  int32_t capacity = sensors.batteryCapacity;
+  int32_t decivolts = (int32_t) (sensors.batteryVoltage * 10);
+  int32_t factor = (int32_t) (sensors.compensation * 100 + 0.5);
+  redrawn += this->show(this->batteryWidget, (capacity * 1000 + decivolts) * 1000 + factor,
+                        "Battery: %d%% %d.%dV x%d.%02d", (int) capacity, (int) decivolts / 10,
+                        (int) decivolts % 10, (int) factor / 100, (int) factor % 100);
+
+  // In steps of 0.1ms so that jitter doesn't redraw it.
+  int32_t busy = (control.busy + 50) / 100;
+  int32_t period = (control.period + 500) / 1000;
+  redrawn += this->show(this->loopWidget, busy * 1000 + period,
+                        "Loop: %d.%dms busy, %dms period", (int) busy / 10, (int) busy % 10, (int) period);
+
+  for(int i = 0; i < _ROBOTSTATE_H_MOTORS; i++) {
+    int32_t temperature = (int32_t) sensors.motorTemperature[i];
+    redrawn += this->show(this->motorWidgets[i], temperature, "%s: %dC", motorNames[i], (int) temperature);
+  }
+
+  return redrawn;
+}
+
+/*
+ * One row per motor, small enough to fit the screen without scrolling: average,
+ * largest and standard deviation of the current, hottest temperature, and seconds at
+ * high current, hot and stalled.
+ */
+void Dashboard::drawStats(const MotorStats& stats) {
+  this->brain.Screen.setFillColor(color::black);
+  this->brain.Screen.setPenColor(color::white);
+  this->brain.Screen.clearScreen();
+  this->brain.Screen.printAt(10, STATS_ROW, "Motors over %d.%ds enabled",
+                             (int) (stats.time / 1000), (int) (stats.time % 1000 / 100));
+  this->brain.Screen.printAt(10, 2 * STATS_ROW, "%-6s %4s %4s %4s %3s %5s %5s %5s",
+                             "", "A", "max", "sd", "C", "high", "hot", "stall");
+
+  for(int32_t i = 0; i < _ROBOTSTATE_H_MOTORS; i++) {
+    const MotorStat& motor = stats.motors[i];
+    bool failing = motor.hotTime > 0 || motor.stallTime > _DASHBOARD_H_STALL_WARNING;
+    this->brain.Screen.setPenColor(failing ? color::red : color::white);
+    this->brain.Screen.printAt(10, (3 + i) * STATS_ROW, "%-6s %4.1f %4.1f %4.2f %3d %5.1f %5.1f %5.1f",
+                               motorNames[i], motor.current.mean, motor.current.max,
+                               sqrt(motor.current.variance()), (int) motor.temperature.max,
+                               motor.highCurrentTime / 1000.0, motor.hotTime / 1000.0,
+                               motor.stallTime / 1000.0);
+  }
+  this->brain.Screen.setPenColor(color::white);
+}
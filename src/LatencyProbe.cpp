@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "LatencyProbe.h"
+#include "Motors.h"
+#include <algorithm>
+#include <stdio.h>
+
+LatencyProbe::LatencyProbe(Subsystem::AxisInput input, int32_t motorPort) :
+  probed(Motors::get(motorPort)) {
+  this->input = input;
+  this->phase = Phase::IDLE;
+  this->lastInput = 0;
+  this->baseline = 0;
+  this->sampleCount = 0;
+}
+
+void LatencyProbe::start() {
+  task(LatencyProbe::run, this, task::taskPriorityHigh);
+}
+
+int LatencyProbe::run(void* probe) {
+  while(true) {
+    ((LatencyProbe*) probe)->poll();
+    task::sleep(_LATENCYPROBE_H_POLL_TIME);
+  }
+  return 0;
+}
+
+void LatencyProbe::poll() {
+  uint64_t now = timer::systemHighResolution();
+
+  if(this->phase == Phase::IDLE) {
+    int32_t value = this->input();
+    if(abs(value - this->lastInput) >= _LATENCYPROBE_H_INPUT_STEP) {
+      this->inputTime = now;
+      this->baseline = this->probed.velocity(percentUnits::pct);
+      this->phase = Phase::WAITING_FOR_TICK;
+    }
+    this->lastInput = value;
+    return;
+  }
+
+  // Giving up always wins: if a tick is part way through, its own move on fails.
+  if(now - this->inputTime > _LATENCYPROBE_H_TIMEOUT * 1000) {
+    this->phase = Phase::IDLE;
+    this->lastInput = this->input();
+    return;
+  }
+
+  if(this->phase != Phase::WAITING_FOR_MOTOR) return;
+  double moved = this->probed.velocity(percentUnits::pct) - this->baseline;
+  if(moved < _LATENCYPROBE_H_RESPONSE && moved > -_LATENCYPROBE_H_RESPONSE) return;
+
+  uint32_t slot = this->sampleCount % _LATENCYPROBE_H_SAMPLES;
+  this->samples[INPUT_TO_SNAPSHOT][slot]   = (uint32_t) (this->snapshotTime - this->inputTime);
+  this->samples[SNAPSHOT_TO_COMMAND][slot] = (uint32_t) (this->commandTime - this->snapshotTime);
+  this->samples[COMMAND_TO_RESPONSE][slot] = (uint32_t) (now - this->commandTime);
+  this->samples[TOTAL][slot]               = (uint32_t) (now - this->inputTime);
+  this->sampleCount++;
+  this->phase = Phase::IDLE;
+  this->lastInput = this->input();
+}
+
+/*
+ * The probe task only reads the times once the phase says they are there, so each one
+ * is written after the move that claims it and before the move that hands it over.
+ */
+void LatencyProbe::tickStarted(uint64_t time) {
+  Phase expected = Phase::WAITING_FOR_TICK;
+  if(!this->phase.compare_exchange_strong(expected, Phase::IN_TICK)) return;
+  this->snapshotTime = time;
+}
+
+void LatencyProbe::tickEnded(uint64_t time) {
+  if(this->phase.load() != Phase::IN_TICK) return;
+  this->commandTime = time;
+  Phase expected = Phase::IN_TICK;
+  this->phase.compare_exchange_strong(expected, Phase::WAITING_FOR_MOTOR);
+}
+
+uint32_t LatencyProbe::getSampleCount() {
+  return this->sampleCount;
+}
+
+uint32_t LatencyProbe::getPercentile(Stage stage, int32_t percent) {
+  int32_t count = std::min(this->sampleCount, (uint32_t) _LATENCYPROBE_H_SAMPLES);
+  if(count == 0) return 0;
+  uint32_t sorted[_LATENCYPROBE_H_SAMPLES];
+  std::copy(this->samples[stage], this->samples[stage] + count, sorted);
+  std::sort(sorted, sorted + count);
+  return sorted[(count - 1) * percent / 100];
+}
+
+void LatencyProbe::report() {
+  static const char* names[STAGE_COUNT] = {
+    "input -> snapshot", "snapshot -> command", "command -> response", "total"
+  };
+  static const Stage stages[STAGE_COUNT] = { INPUT_TO_SNAPSHOT, SNAPSHOT_TO_COMMAND, COMMAND_TO_RESPONSE, TOTAL };
+
+  printf("latency over %u samples, in ms:     min   median    p90    max\n",
+         (unsigned) std::min(this->sampleCount, (uint32_t) _LATENCYPROBE_H_SAMPLES));
+  for(int32_t i = 0; i < STAGE_COUNT; i++) {
+    printf("  %-20s %14.2f %8.2f %6.2f %6.2f\n", names[i],
+           this->getPercentile(stages[i], 0) / 1000.0, this->getPercentile(stages[i], 50) / 1000.0,
+           this->getPercentile(stages[i], 90) / 1000.0, this->getPercentile(stages[i], 100) / 1000.0);
+  }
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Logger.h"
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+
+// Room left for one more line; the buffer is written out before it gets any fuller.
+#define LINE_SPACE 256
+
+Logger::Logger() {
+  this->length = 0;
+  this->lastFlush = 0;
+  this->started = false;
+  this->summarized = false;
+}
+
+void Logger::start() {
+  task(Logger::run, this, task::taskPrioritylow);
+}
+
+int Logger::run(void* logger) {
+  while(true) {
+    ((Logger*) logger)->update();
+    task::sleep(_LOGGER_H_PERIOD);
+  }
+  return 0;
+}
+
+void Logger::append(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  int written = vsnprintf(this->buffer + this->length, _LOGGER_H_BUFFER - this->length, format, args);
+  va_end(args);
+  if(written > 0) this->length += written;
+  if(this->length > _LOGGER_H_BUFFER - 1) this->length = _LOGGER_H_BUFFER - 1;
+}
+
+void Logger::update() {
+  ControlState control;
+  SensorState sensors;
+  if(!this->brain.SDcard.isInserted() || !controlState.read(control) || !sensorState.read(sensors)) return;
+
+  // Not optional, and the robot has nothing else to do once it is disabled.
+  MotorStats stats;
+  if(motorStats.read(stats)) {
+    if(stats.running) this->summarized = false;
+    else if(stats.time > 0 && !this->summarized) {
+      this->writeSummary(stats);
+      this->summarized = true;
+    }
+  }
+
+  // Only while enabled, so that a robot left on in the pits doesn't fill the card.
+  // Whatever is still waiting goes out as soon as it is disabled.
+  if(!control.enabled) {
+    this->flush();
+    return;
+  }
+  if(control.watchdogLevel != Watchdog::Level::NORMAL) return;
+
+  // Every run appends to the same file, so only the first one writes the header.
+  if(!this->started && !this->brain.SDcard.exists(_LOGGER_H_FILE)) {
+    this->append("time,lift_state,lift_height,drive_distance,jammed,busy_us,period_us,overruns,battery_v,compensation");
+    for(int32_t i = 0; i < _ROBOTSTATE_H_MOTORS; i++) this->append(",temp_%d", (int) motorPorts[i] + 1);
+    this->append(",slip_fl,slip_fr,slip_bl,slip_br,overrun_by\n");
+  }
+  if(!this->started) {
+    this->lastFlush = control.time;
+    this->started = true;
+  }
+
+  this->append("%u,%d,%.3f,%.3f,%d,%u,%u,%u,%.2f,%.3f", (unsigned) control.time, (int) control.liftState,
+               control.liftHeight, control.driveDistance, (int) control.intakeJammed, (unsigned) control.busy,
+               (unsigned) control.period, (unsigned) control.overruns, sensors.batteryVoltage,
+               sensors.compensation);
+  for(int32_t i = 0; i < _ROBOTSTATE_H_MOTORS; i++) this->append(",%.0f", sensors.motorTemperature[i]);
+  for(double slip : control.wheelSlip) this->append(",%.2f", slip);
+  // Left empty until the first overrun.
+  if(control.overruns > 0) this->append(",%d\n", (int) control.overrunBy);
+  else this->append(",\n");
+
+  if(this->length > _LOGGER_H_BUFFER - LINE_SPACE || control.time - this->lastFlush >= _LOGGER_H_FLUSH_TIME) {
+    this->flush();
+    this->lastFlush = control.time;
+  }
+}
+
+/*
+ * Goes through the same buffer as the log, so whatever log lines are waiting go out
+ * first.
+ */
+void Logger::writeSummary(const MotorStats& stats) {
+  this->flush();
+
+  if(!this->brain.SDcard.exists(_LOGGER_H_SUMMARY_FILE)) {
+    this->append("time,enabled_s");
+    for(int32_t i = 0; i < _ROBOTSTATE_H_MOTORS; i++) {
+      int port = (int) motorPorts[i] + 1;
+      this->append(",amps_%d,amps_max_%d,amps_sd_%d,temp_max_%d,high_s_%d,hot_s_%d,stall_s_%d",
+                   port, port, port, port, port, port, port);
+    }
+    this->append("\n");
+  }
+
+  this->append("%u,%.1f", (unsigned) timer::system(), stats.time / 1000.0);
+  for(const MotorStat& motor : stats.motors) {
+    this->append(",%.2f,%.2f,%.2f,%.0f,%.1f,%.1f,%.1f", motor.current.mean, motor.current.max,
+                 sqrt(motor.current.variance()), motor.temperature.max, motor.highCurrentTime / 1000.0,
+                 motor.hotTime / 1000.0, motor.stallTime / 1000.0);
+  }
+  this->append("\n");
+
+  this->brain.SDcard.appendfile(_LOGGER_H_SUMMARY_FILE, (uint8_t*) this->buffer, this->length);
+  this->length = 0;
+}
+
+void Logger::flush() {
+  if(this->length == 0) return;
+  this->brain.SDcard.appendfile(_LOGGER_H_FILE, (uint8_t*) this->buffer, this->length);
+  this->length = 0;
+}
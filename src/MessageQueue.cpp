@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "MessageQueue.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+using namespace vex;
+
+MessageQueue controllerMessages;
+
+MessageQueue::MessageQueue() {
+  for(int i = 0; i < _MESSAGEQUEUE_H_LINES; i++) {
+    this->lines[i].text[0] = '\0';
+    this->lines[i].shown[0] = '\0';
+    this->lines[i].posted = 0;
+    this->lines[i].pending = false;
+  }
+  this->rumblePattern = nullptr;
+  this->rumblePosted = 0;
+  this->controller = nullptr;
+}
+
+void MessageQueue::post(int32_t line, const char* format, ...) {
+  if(line < 1 || line > _MESSAGEQUEUE_H_LINES) return;
+
+  // Format before taking the lock, so it is held for as short a time as possible.
+  char text[_MESSAGEQUEUE_H_WIDTH + 1];
+  va_list args;
+  va_start(args, format);
+  vsnprintf(text, sizeof(text), format, args);
+  va_end(args);
+
+  this->lock.lock();
+  Line& slot = this->lines[line - 1];
+  if(slot.pending ? strcmp(slot.text, text) != 0 : strcmp(slot.shown, text) != 0) {
+    strcpy(slot.text, text);
+    slot.posted = timer::system();
+    slot.pending = true;
+  }
+  this->lock.unlock();
+}
+
+void MessageQueue::rumble(const char* pattern) {
+  this->lock.lock();
+  this->rumblePattern = pattern;
+  this->rumblePosted = timer::system();
+  this->lock.unlock();
+}
+
+void MessageQueue::start(vex::controller* controller) {
+  this->controller = controller;
+  task(MessageQueue::run, this, task::taskPrioritylow);
+}
+
+int MessageQueue::run(void* queue) {
+  MessageQueue* self = (MessageQueue*) queue;
+  while(true) {
+    self->send(self->controller);
+    task::sleep(_MESSAGEQUEUE_H_SEND_TIME);
+  }
+  return 0;
+}
+
+bool MessageQueue::send(vex::controller* controller) {
+  uint32_t now = timer::system();
+  const char* pattern = nullptr;
+  int32_t line = 0;
+  char text[_MESSAGEQUEUE_H_WIDTH + 1];
+
+  // Pick what to send while holding the lock, but talk to the controller without it,
+  // so that `post()` and `rumble()` never wait for more than these few copies.
+  this->lock.lock();
+  if(this->rumblePattern != nullptr && now - this->rumblePosted > _MESSAGEQUEUE_H_MAX_AGE) {
+    this->rumblePattern = nullptr;
+  }
+  if(this->rumblePattern != nullptr) {
+    pattern = this->rumblePattern;
+    this->rumblePattern = nullptr;
+  } else {
+    for(int i = 0; i < _MESSAGEQUEUE_H_LINES; i++) {
+      Line& slot = this->lines[i];
+      if(slot.pending && now - slot.posted > _MESSAGEQUEUE_H_MAX_AGE) slot.pending = false;
+      if(slot.pending && (line == 0 || slot.posted < this->lines[line - 1].posted)) line = i + 1;
+    }
+    if(line != 0) {
+      Line& slot = this->lines[line - 1];
+      strcpy(text, slot.text);
+      strcpy(slot.shown, slot.text);
+      slot.pending = false;
+    }
+  }
+  this->lock.unlock();
+
+  if(pattern != nullptr) {
+    controller->rumble(pattern);
+    return true;
+  }
+  if(line != 0) {
+    // Padded so that a shorter message covers a longer one.
+    controller->Screen.setCursor(line, 1);
+    controller->Screen.print("%-*s", _MESSAGEQUEUE_H_WIDTH, text);
+    return true;
+  }
+  return false;
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "MotorStats.h"
+#include <math.h>
+
+void RunningStat::reset() {
+  this->count = 0;
+  this->min = this->max = this->mean = this->m2 = 0;
+}
+
+void RunningStat::add(double value) {
+  if(this->count == 0 || value < this->min) this->min = value;
+  if(this->count == 0 || value > this->max) this->max = value;
+  this->count++;
+  double delta = value - this->mean;
+  this->mean += delta / this->count;
+  this->m2 += delta * (value - this->mean);
+}
+
+double RunningStat::variance() const {
+  return this->count > 1 ? this->m2 / (this->count - 1) : 0;
+}
+
+void MotorStats::reset() {
+  this->time = 0;
+  this->running = false;
+  for(MotorStat& motor : this->motors) {
+    motor.current.reset();
+    motor.temperature.reset();
+    motor.highCurrentTime = motor.hotTime = motor.stallTime = 0;
+  }
+}
+
+void MotorStats::add(const double* current, const double* temperature, const double* velocity, uint32_t dt) {
+  this->time += dt;
+  for(int32_t i = 0; i < _MOTORSTATS_H_MOTORS; i++) {
+    MotorStat& motor = this->motors[i];
+    motor.current.add(current[i]);
+    motor.temperature.add(temperature[i]);
+    if(current[i] > _MOTORSTATS_H_HIGH_CURRENT) motor.highCurrentTime += dt;
+    if(temperature[i] >= _MOTORSTATS_H_HOT) motor.hotTime += dt;
+    if(current[i] > _MOTORSTATS_H_STALL_CURRENT && fabs(velocity[i]) < _MOTORSTATS_H_STALL_SPEED) {
+      motor.stallTime += dt;
+    }
+  }
+}
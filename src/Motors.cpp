@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Motors.h"
+#include "RobotState.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * Checked at compile time rather than found on the robot: two subsystems on the same
+ * port fight each other without any error, and a port past the last one is just a
+ * motor that never moves.
+ */
+static constexpr int32_t ports[] = { MOTOR_PORTS };
+static constexpr int32_t count = sizeof(ports) / sizeof(ports[0]);
+
+// Whether ports[i] is a real port and differs from every port after it, and so on for
+// every port from i on.
+static constexpr bool valid(int32_t i, int32_t j) {
+  return i >= count ? true :
+         j >= count ? ports[i] >= 0 && ports[i] < _MOTORS_H_PORTS && valid(i + 1, i + 2) :
+         ports[i] != ports[j] && valid(i, j + 1);
+}
+
+static_assert(count == _ROBOTSTATE_H_MOTORS, "MOTOR_PORTS must list every motor in motorPorts");
+static_assert(valid(0, 1), "two motors in RobotMap.h are on the same port, or on no port at all");
+
+motor* Motors::handles() {
+  static motor all[_MOTORS_H_PORTS] = {
+    motor(PORT1),  motor(PORT2),  motor(PORT3),  motor(PORT4),  motor(PORT5),
+    motor(PORT6),  motor(PORT7),  motor(PORT8),  motor(PORT9),  motor(PORT10),
+    motor(PORT11), motor(PORT12), motor(PORT13), motor(PORT14), motor(PORT15),
+    motor(PORT16), motor(PORT17), motor(PORT18), motor(PORT19), motor(PORT20),
+    motor(PORT21)
+  };
+  return all;
+}
+
+/*
+ * Ports that are not in RobotMap.h (e.g. LatencyProbe's) are only known at run time.
+ * Subsystems keep the handle by reference, so there is no sensible motor to hand back
+ * for a bad port; stop at startup with the port on the terminal instead of indexing
+ * past the end.
+ */
+motor& Motors::get(int32_t port) {
+  if(port < 0 || port >= _MOTORS_H_PORTS) {
+    printf("motors: port %d is not PORT1 to PORT%d\n", (int) port, _MOTORS_H_PORTS);
+    abort();
+  }
+  return handles()[port];
+}
+
+void Motors::sample(double temperature[], double current[], double velocity[]) {
+  motor* all = handles();
+  for(int32_t i = 0; i < _ROBOTSTATE_H_MOTORS; i++) {
+    motor& sampled = all[motorPorts[i]];
+    temperature[i] = sampled.temperature(temperatureUnits::celsius);
+    current[i] = sampled.current(currentUnits::amp);
+    velocity[i] = sampled.velocity(percentUnits::pct);
+  }
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Sensing.h"
+#include "Compensation.h"
+#include "Motors.h"
+
+// Between the low-priority UI and logging tasks and the high-priority control task.
+#define SENSING_PRIORITY ((task::taskPrioritylow + task::taskPriorityHigh) / 2)
+
+Sensing::Sensing() {
+  this->sampled = false;
+  this->stats.reset();
+  this->enabled = false;
+  this->lastSample = this->disabledSince = 0;
+  this->unpublished = 0;
+}
+
+void Sensing::start() {
+  task(Sensing::run, this, SENSING_PRIORITY);
+}
+
+int Sensing::run(void* sensing) {
+  uint32_t next = timer::system();
+  while(true) {
+    ((Sensing*) sensing)->update();
+    // Keep to a fixed rate rather than a fixed sleep, so sampling time doesn't add up.
+    next += _SENSING_H_PERIOD;
+    int32_t remaining = (int32_t) (next - timer::system());
+    if(remaining > 0) task::sleep(remaining);
+    else next = timer::system();
+  }
+  return 0;
+}
+
+void Sensing::update() {
+  SensorState& state = this->state;
+  state.time = timer::system();
+
+  double voltage = this->brain.Battery.voltage();
+  if(!this->sampled) state.batteryVoltage = voltage;
+  else state.batteryVoltage += _SENSING_H_BATTERY_FILTER * (voltage - state.batteryVoltage);
+  batteryCompensation.setBatteryVoltage(state.batteryVoltage);
+  state.compensation = batteryCompensation.getFactor();
+  state.batteryCurrent = this->brain.Battery.current();
+  state.batteryCapacity = this->brain.Battery.capacity();
+
+  Motors::sample(state.motorTemperature, state.motorCurrent, state.motorVelocity);
+
+  this->updateStats();
+  this->sampled = true;
+  sensorState.write(state);
+}
+
+/*
+ * A match is one set of statistics: enabling the robot again straight after it was
+ * disabled (autonomous into driver control) carries on with the same set, and only a
+ * longer break starts a new one.  The set is published one last time as the robot is
+ * disabled, marked as no longer running, which is what the dashboard and logger wait
+ * for.
+ */
+void Sensing::updateStats() {
+  ControlState control;
+  bool enabled = controlState.read(control) && control.enabled;
+  uint32_t now = this->state.time;
+
+  if(enabled) {
+    if(!this->enabled && now - this->disabledSince > _MOTORSTATS_H_MATCH_GAP) this->stats.reset();
+    if(this->enabled) {
+      this->stats.add(this->state.motorCurrent, this->state.motorTemperature,
+                      this->state.motorVelocity, now - this->lastSample);
+    }
+    this->stats.running = true;
+    if(++this->unpublished >= _SENSING_H_STATS_EVERY) {
+      motorStats.write(this->stats);
+      this->unpublished = 0;
+    }
+  } else if(this->enabled) {
+    this->stats.running = false;
+    motorStats.write(this->stats);
+    this->disabledSince = now;
+  }
+
+  this->enabled = enabled;
+  this->lastSample = now;
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Startup.h"
+#include <stdio.h>
+
+using namespace vex;
+
+// Above the UI and logging tasks, so setup isn't kept waiting behind them.
+#define STARTUP_PRIORITY ((task::taskPrioritylow + task::taskPriorityHigh) / 2)
+
+Startup::Startup() {
+  this->count = 0;
+  this->started = 0;
+}
+
+bool Startup::add(const char* name, std::function<void()> step) {
+  if(this->count >= _STARTUP_H_STEPS) return false;
+  Step& added = this->steps[this->count++];
+  added.name = name;
+  added.run = step;
+  added.done = false;
+  added.started = added.finished = 0;
+  return true;
+}
+
+void Startup::start() {
+  this->started = timer::systemHighResolution();
+  for(int32_t i = 0; i < this->count; i++) {
+    task(Startup::run, &this->steps[i], STARTUP_PRIORITY);
+  }
+}
+
+int Startup::run(void* step) {
+  Step* running = (Step*) step;
+  running->started = timer::systemHighResolution();
+  running->run();
+  running->finished = timer::systemHighResolution();
+  running->done = true;
+  return 0;
+}
+
+bool Startup::isDone() const {
+  return this->getPending() == nullptr;
+}
+
+bool Startup::wait(uint32_t timeout) {
+  uint64_t deadline = this->started + (uint64_t) timeout * 1000;
+  while(!this->isDone()) {
+    if(timer::systemHighResolution() >= deadline) return false;
+    task::sleep(_STARTUP_H_POLL_TIME);
+  }
+  return true;
+}
+
+const char* Startup::getPending() const {
+  for(int32_t i = 0; i < this->count; i++) {
+    if(!this->steps[i].done) return this->steps[i].name;
+  }
+  return nullptr;
+}
+
+uint32_t Startup::getElapsed() const {
+  uint64_t last = this->started;
+  for(int32_t i = 0; i < this->count; i++) {
+    const Step& step = this->steps[i];
+    uint64_t finished = step.done ? step.finished : timer::systemHighResolution();
+    if(finished > last) last = finished;
+  }
+  return (uint32_t) ((last - this->started) / 1000);
+}
+
+void Startup::report() const {
+  // Time spent in each step added up, against how long setup took from start to end;
+  // the difference is what running them at once saved.
+  uint64_t sum = 0;
+  printf("startup:                  start   time (ms)\n");
+  for(int32_t i = 0; i < this->count; i++) {
+    const Step& step = this->steps[i];
+    if(!step.done) {
+      printf("  %-20s  not finished\n", step.name);
+      continue;
+    }
+    sum += step.finished - step.started;
+    printf("  %-20s %8.1f %8.1f\n", step.name,
+      (step.started - this->started) / 1000.0, (step.finished - step.started) / 1000.0);
+  }
+  printf("  total %u ms, steps add up to %.1f ms\n", (unsigned) this->getElapsed(), sum / 1000.0);
+}
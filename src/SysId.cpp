@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "SysId.h"
+#include <stdio.h>
+
+// Size of the chunks `save()` writes the file in.
+#define CHUNK 4096
+
+SysId::SysId(MecanumDriveTank* drive) :
+  recording(false), volts(0), sampleCount(0) {
+  this->mechanism = Mechanism::DRIVE;
+  this->drive = drive;
+  this->lift = nullptr;
+  this->test = Test::RAMP_FORWARD;
+  this->testStart = 0;
+  this->holdVolts = 0;
+}
+
+SysId::SysId(RD4BLift* lift) :
+  recording(false), volts(0), sampleCount(0) {
+  this->mechanism = Mechanism::LIFT;
+  this->drive = nullptr;
+  this->lift = lift;
+  this->test = Test::RAMP_FORWARD;
+  this->testStart = 0;
+  this->holdVolts = 0;
+}
+
+void SysId::start() {
+  task(SysId::run, this, task::taskPriorityHigh);
+}
+
+int SysId::run(void* sysid) {
+  uint32_t next = timer::system();
+  while(true) {
+    ((SysId*) sysid)->sample();
+    next += _SYSID_H_PERIOD;
+    int32_t remaining = (int32_t) (next - timer::system());
+    if(remaining > 0) task::sleep(remaining);
+    else next = timer::system();
+  }
+  return 0;
+}
+
+/*
+ * Only this function adds samples, and it publishes each one by bumping the count
+ * after filling it in, so `getSample()` never sees one half-written.
+ */
+void SysId::sample() {
+  if(!this->recording.load()) return;
+  uint32_t count = this->sampleCount.load();
+  if(count >= _SYSID_H_SAMPLES) return;
+
+  Sample& sample = this->samples[count];
+  sample.time = (uint32_t) (timer::systemHighResolution() - this->testStart);
+  sample.test = (uint8_t) this->test;
+  sample.volts = this->volts.load();
+  sample.speed = (float) this->getSpeed();
+  sample.position = (float) this->getPosition();
+  this->sampleCount.store(count + 1);
+}
+
+void SysId::begin(Test test) {
+  this->test = test;
+  this->volts = 0;
+  this->testStart = timer::systemHighResolution();
+  this->recording = true;
+}
+
+void SysId::end() {
+  this->recording = false;
+}
+
+void SysId::clear() {
+  if(this->recording.load()) return;
+  this->sampleCount = 0;
+  this->holdVolts = 0;
+}
+
+void SysId::apply(double volts) {
+  this->volts = (float) volts;
+  if(this->mechanism == Mechanism::DRIVE) this->drive->setVoltage(volts);
+  else this->lift->setVoltage(volts);
+}
+
+void SysId::stop() {
+  this->volts = 0;
+  if(this->mechanism == Mechanism::DRIVE) this->drive->stop(brakeType::brake);
+  else this->lift->stop(brakeType::hold);
+}
+
+void SysId::setHoldVoltage(double volts) {
+  this->holdVolts = volts;
+}
+
+double SysId::getHoldVoltage() {
+  return this->holdVolts;
+}
+
+double SysId::getSpeed() {
+  if(this->mechanism == Mechanism::DRIVE) return this->drive->getSpeed();
+  return this->lift->getSpeed();
+}
+
+double SysId::getPosition() {
+  if(this->mechanism == Mechanism::DRIVE) return this->drive->getDistance();
+  return this->lift->getHeight();
+}
+
+SysId::Mechanism SysId::getMechanism() {
+  return this->mechanism;
+}
+
+Subsystem* SysId::getSubsystem() {
+  if(this->mechanism == Mechanism::DRIVE) return this->drive;
+  return this->lift;
+}
+
+uint32_t SysId::getSampleCount() {
+  return this->sampleCount.load();
+}
+
+bool SysId::isFull() {
+  return this->sampleCount.load() >= _SYSID_H_SAMPLES;
+}
+
+const SysId::Sample& SysId::getSample(uint32_t index) {
+  return this->samples[index];
+}
+
+int32_t SysId::save() {
+  if(!this->brain.SDcard.isInserted()) return -1;
+
+  static char buffer[CHUNK];
+  int32_t length = snprintf(buffer, CHUNK, "# %s\ntest,time_us,volts,speed,position\n",
+                            this->mechanism == Mechanism::DRIVE ? "drive" : "lift");
+  this->brain.SDcard.savefile(_SYSID_H_FILE, (uint8_t*) buffer, length);
+
+  uint32_t count = this->sampleCount.load();
+  length = 0;
+  for(uint32_t i = 0; i < count; i++) {
+    const Sample& sample = this->samples[i];
+    length += snprintf(buffer + length, CHUNK - length, "%u,%u,%.3f,%.2f,%.4f\n",
+                       (unsigned) sample.test, (unsigned) sample.time,
+                       sample.volts, sample.speed, sample.position);
+    if(length > CHUNK - 64 || i + 1 == count) {
+      this->brain.SDcard.appendfile(_SYSID_H_FILE, (uint8_t*) buffer, length);
+      length = 0;
+    }
+  }
+  return (int32_t) count;
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Trajectory.h"
+
+/*
+ * The points are evenly spaced in time, so the two around `time` are found by division
+ * rather than a search, and the whole thing is a handful of multiplies per field.
+ */
+TrajectorySample sampleTrajectory(const Trajectory& trajectory, double time) {
+  int32_t last = trajectory.count - 1;
+  double position = time / trajectory.period;
+  bool moving = position > 0 && position < last;
+  if(position < 0) position = 0;
+  if(position > last) position = last;
+
+  int32_t i = (int32_t) position;
+  if(i >= last) i = last > 0 ? last - 1 : 0;
+  double t = position - i;
+  const TrajectoryPoint& a = trajectory.points[i];
+  const TrajectoryPoint& b = trajectory.points[last > 0 ? i + 1 : i];
+
+  auto lerp = [t](int16_t from, int16_t to, double scale) -> double {
+    return (from + t * (to - from)) / scale;
+  };
+
+  TrajectorySample sample;
+  sample.x       = lerp(a.x, b.x, _TRAJECTORY_H_LENGTH_SCALE);
+  sample.y       = lerp(a.y, b.y, _TRAJECTORY_H_LENGTH_SCALE);
+  sample.heading = lerp(a.heading, b.heading, _TRAJECTORY_H_ANGLE_SCALE);
+  sample.forward = lerp(a.forward, b.forward, _TRAJECTORY_H_LENGTH_SCALE);
+  sample.strafe  = lerp(a.strafe, b.strafe, _TRAJECTORY_H_LENGTH_SCALE);
+  sample.turn    = lerp(a.turn, b.turn, _TRAJECTORY_H_ANGLE_SCALE);
+  for(int w = 0; w < 4; w++) {
+    sample.wheelSpeed[w] = lerp(a.wheelSpeed[w], b.wheelSpeed[w], _TRAJECTORY_H_SPEED_SCALE);
+    sample.wheelPosition[w] = lerp(a.wheelPosition[w], b.wheelPosition[w], _TRAJECTORY_H_POSITION_SCALE);
+    sample.wheelAcceleration[w] = moving
+      ? (b.wheelSpeed[w] - a.wheelSpeed[w]) * 1000.0 / _TRAJECTORY_H_SPEED_SCALE / trajectory.period
+      : 0;
+  }
+  return sample;
+}
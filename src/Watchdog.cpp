@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "Watchdog.h"
+#include "MessageQueue.h"
+
+Watchdog::Watchdog(Scheduler* scheduler, uint32_t budget) {
+  this->scheduler = scheduler;
+  this->budget = budget;
+  this->nonCriticalCount = 0;
+  this->level = Level::NORMAL;
+  this->misses = 0;
+  this->goodTicks = 0;
+  this->overruns = 0;
+}
+
+void Watchdog::setNonCritical(Subsystem* subsystem) {
+  if(this->nonCriticalCount < _SCHEDULER_H_MAX_SUBSYSTEMS) {
+    this->nonCritical[this->nonCriticalCount++] = subsystem;
+  }
+}
+
+void Watchdog::check(uint64_t start, uint64_t end) {
+  uint32_t duration = (uint32_t) (end - start);
+
+  if(duration <= this->budget) {
+    if(++this->goodTicks >= _WATCHDOG_H_RECOVER) {
+      this->goodTicks = 0;
+      this->misses = 0;
+      if(this->level != Level::NORMAL) {
+        this->level = (Level) (this->level - 1);
+        this->applyLevel();
+      }
+    }
+    return;
+  }
+
+  // Blame whichever part of the tick took the longest.
+  int32_t offender = -1;
+  uint32_t slowest = this->scheduler->getCommandDuration();
+  for(int32_t i = 0; i < this->scheduler->getSubsystemCount(); i++) {
+    if(this->scheduler->getDuration(i) > slowest) {
+      slowest = this->scheduler->getDuration(i);
+      offender = i;
+    }
+  }
+
+  Overrun& overrun = this->log[this->overruns % _WATCHDOG_H_LOG];
+  overrun.time = timer::system();
+  overrun.duration = duration;
+  overrun.offender = offender;
+  this->overruns++;
+
+  this->goodTicks = 0;
+  if(++this->misses >= _WATCHDOG_H_MISSES && this->level != Level::REDUCED_RATE) {
+    this->misses = 0;
+    this->level = (Level) (this->level + 1);
+    this->applyLevel();
+  }
+}
+
+/*
+ * Also lets the driver know, since a robot that has started shedding work is one that
+ * needs looking at after the match.
+ */
+void Watchdog::applyLevel() {
+  int32_t interval = this->level == Level::REDUCED_RATE ? _WATCHDOG_H_SLOW_INTERVAL : 1;
+  for(int32_t i = 0; i < this->nonCriticalCount; i++) {
+    this->scheduler->setInterval(this->nonCritical[i], interval);
+  }
+
+  static const char* names[] = { "ok", "no extras", "reduced rate" };
+  controllerMessages.post(3, "Loop: %s", names[this->level]);
+}
+
+Watchdog::Level Watchdog::getLevel() {
+  return this->level;
+}
+
+bool Watchdog::extrasEnabled() {
+  return this->level == Level::NORMAL;
+}
+
+uint32_t Watchdog::getOverrunCount() {
+  return this->overruns;
+}
+
+const Watchdog::Overrun& Watchdog::getOverrun(int32_t n) {
+  return this->log[(this->overruns - 1 - n) % _WATCHDOG_H_LOG];
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "commands/Command.h"
+#include "commands/CommandPool.h"
+#include <stdio.h>
+
+Command::Command(int32_t priority) {
+  this->requirementCount = 0;
+  this->priority = priority;
+  this->pool = nullptr;
+}
+
+Command::~Command() {}
+
+// Default lifecycle hooks do nothing, so subclasses only override what they need.
+void Command::initialize() {}
+void Command::execute() {}
+bool Command::isFinished() { return false; }
+void Command::end(bool interrupted) {}
+
+/*
+ * Requirements are kept in a small fixed array rather than a container so that
+ * commands can live in a `CommandPool` without allocating.  A command that runs out
+ * of room would be scheduled alongside commands it actually conflicts with, so say so
+ * on the terminal rather than dropping the requirement quietly.
+ */
+bool Command::addRequirement(Subsystem* subsystem) {
+  if(subsystem == nullptr) return false;
+  if(this->hasRequirement(subsystem)) return true;
+  if(this->requirementCount >= _COMMAND_H_MAX_REQUIREMENTS) {
+    printf("command: more than %d requirements, one was dropped\n", _COMMAND_H_MAX_REQUIREMENTS);
+    return false;
+  }
+  this->requirements[this->requirementCount++] = subsystem;
+  return true;
+}
+
+bool Command::hasRequirement(Subsystem* subsystem) const {
+  for(int32_t i = 0; i < this->requirementCount; i++) {
+    if(this->requirements[i] == subsystem) return true;
+  }
+  return false;
+}
+
+bool Command::conflictsWith(const Command* other) const {
+  for(int32_t i = 0; i < this->requirementCount; i++) {
+    if(other->hasRequirement(this->requirements[i])) return true;
+  }
+  return false;
+}
+
+int32_t Command::getRequirementCount() const {
+  return this->requirementCount;
+}
+
+Subsystem* Command::getRequirement(int32_t index) const {
+  return this->requirements[index];
+}
+
+int32_t Command::getPriority() const {
+  return this->priority;
+}
+
+void Command::setPriority(int32_t priority) {
+  this->priority = priority;
+}
+
+/*
+ * Hand the command back to its pool, which runs the destructor.  Nothing may touch
+ * `this` after the call.
+ */
+void Command::release() {
+  if(this->pool != nullptr) this->pool->release(this);
+}
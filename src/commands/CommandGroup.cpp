@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "commands/CommandGroup.h"
+#include <stdio.h>
+
+CommandGroup::CommandGroup(int32_t priority) : Command(priority) {
+  this->commandCount = 0;
+}
+
+/*
+ * Children are released along with the group, so a whole routine built out of pooled
+ * commands goes back to the pools in one go when the scheduler is done with it.
+ */
+CommandGroup::~CommandGroup() {
+  for(int32_t i = 0; i < this->commandCount; i++) this->commands[i]->release();
+}
+
+/*
+ * Two children of a parallel or race group that share a subsystem would both drive it
+ * every tick, and the scheduler cannot see it since the group holds the requirement
+ * once.  Refuse the second one and say so, so the mistake shows up when the routine
+ * is built rather than on the field.
+ */
+bool CommandGroup::add(Command* command) {
+  if(command == nullptr) {
+    printf("group: child is nullptr, is its pool exhausted?\n");
+    return false;
+  }
+  if(this->commandCount >= _COMMANDGROUP_H_MAX_COMMANDS) {
+    printf("group: more than %d children, one was dropped\n", _COMMANDGROUP_H_MAX_COMMANDS);
+    command->release();
+    return false;
+  }
+  if(this->runsChildrenTogether()) {
+    for(int32_t i = 0; i < this->commandCount; i++) {
+      if(!this->commands[i]->conflictsWith(command)) continue;
+      printf("group: child %d shares a subsystem with child %d and was dropped\n",
+             (int) this->commandCount, (int) i);
+      command->release();
+      return false;
+    }
+  }
+  this->commands[this->commandCount] = command;
+  this->running[this->commandCount] = false;
+  this->commandCount++;
+  bool added = true;
+  for(int32_t i = 0; i < command->getRequirementCount(); i++) {
+    added = this->addRequirement(command->getRequirement(i)) && added;
+  }
+  return added;
+}
+
+bool CommandGroup::runsChildrenTogether() const {
+  return true;
+}
+
+/*
+ * SequentialGroup: only `commands[current]` is ever running.
+ */
+SequentialGroup::SequentialGroup(int32_t priority) : CommandGroup(priority) {
+  this->current = 0;
+}
+
+void SequentialGroup::initialize() {
+  this->current = 0;
+  if(this->commandCount > 0) this->commands[0]->initialize();
+}
+
+void SequentialGroup::execute() {
+  if(this->current >= this->commandCount) return;
+  Command* command = this->commands[this->current];
+  command->execute();
+  if(command->isFinished()) {
+    command->end(false);
+    // Start the next command right away rather than wasting a tick.
+    if(++this->current < this->commandCount) this->commands[this->current]->initialize();
+  }
+}
+
+// Children take turns, so they may share subsystems.
+bool SequentialGroup::runsChildrenTogether() const {
+  return false;
+}
+
+bool SequentialGroup::isFinished() {
+  return this->current >= this->commandCount;
+}
+
+void SequentialGroup::end(bool interrupted) {
+  if(interrupted && this->current < this->commandCount) {
+    this->commands[this->current]->end(true);
+  }
+}
+
+/*
+ * ParallelGroup: children that finish early are ended individually and left alone
+ * until the rest catch up.
+ */
+ParallelGroup::ParallelGroup(int32_t priority) : CommandGroup(priority) {}
+
+void ParallelGroup::initialize() {
+  for(int32_t i = 0; i < this->commandCount; i++) {
+    this->commands[i]->initialize();
+    this->running[i] = true;
+  }
+}
+
+void ParallelGroup::execute() {
+  for(int32_t i = 0; i < this->commandCount; i++) {
+    if(!this->running[i]) continue;
+    this->commands[i]->execute();
+    if(this->commands[i]->isFinished()) {
+      this->commands[i]->end(false);
+      this->running[i] = false;
+    }
+  }
+}
+
+bool ParallelGroup::isFinished() {
+  for(int32_t i = 0; i < this->commandCount; i++) {
+    if(this->running[i]) return false;
+  }
+  return true;
+}
+
+void ParallelGroup::end(bool interrupted) {
+  for(int32_t i = 0; i < this->commandCount; i++) {
+    if(this->running[i]) this->commands[i]->end(true);
+    this->running[i] = false;
+  }
+}
+
+/*
+ * RaceGroup: every child runs until the first one finishes; the winner is ended
+ * normally and everyone else is interrupted.
+ */
+RaceGroup::RaceGroup(int32_t priority) : CommandGroup(priority) {
+  this->finished = false;
+}
+
+void RaceGroup::initialize() {
+  this->finished = false;
+  for(int32_t i = 0; i < this->commandCount; i++) {
+    this->commands[i]->initialize();
+    this->running[i] = true;
+  }
+}
+
+void RaceGroup::execute() {
+  for(int32_t i = 0; i < this->commandCount; i++) {
+    this->commands[i]->execute();
+    if(this->commands[i]->isFinished()) {
+      this->commands[i]->end(false);
+      this->running[i] = false;
+      this->finished = true;
+      break;
+    }
+  }
+}
+
+bool RaceGroup::isFinished() {
+  return this->finished || this->commandCount == 0;
+}
+
+void RaceGroup::end(bool interrupted) {
+  for(int32_t i = 0; i < this->commandCount; i++) {
+    if(this->running[i]) this->commands[i]->end(true);
+    this->running[i] = false;
+  }
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "commands/DriveCommand.h"
+
+DriveCommand::DriveCommand( MecanumDriveTank* drive,
+                            int32_t forward,
+                            int32_t strafe,
+                            int32_t turn,
+                            double distance ) {
+  this->drive = drive;
+  this->forward = forward;
+  this->strafe = strafe;
+  this->turn = turn;
+  this->distance = distance;
+  this->start = 0;
+  this->addRequirement(drive);
+}
+
+void DriveCommand::initialize() {
+  this->start = this->drive->getDistance();
+}
+
+// Reapply the powers every tick, same as `MecanumDriveTank::update()` would.
+void DriveCommand::execute() {
+  this->drive->drive(this->forward, this->strafe, this->turn);
+}
+
+bool DriveCommand::isFinished() {
+  double travelled = this->drive->getDistance() - this->start;
+  if(travelled < 0) travelled = -travelled;
+  return travelled >= this->distance;
+}
+
+void DriveCommand::end(bool interrupted) {
+  this->drive->stop(brakeType::brake);
+}
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "commands/Scheduler.h"
+
+Scheduler::Scheduler(Subsystem** subsystems, int32_t count) {
+  this->subsystems = subsystems;
+  this->subsystemCount = count < _SCHEDULER_H_MAX_SUBSYSTEMS ? count : _SCHEDULER_H_MAX_SUBSYSTEMS;
+  for(int32_t i = 0; i < _SCHEDULER_H_MAX_COMMANDS; i++) this->commands[i] = nullptr;
+  for(int32_t i = 0; i < _SCHEDULER_H_MAX_SUBSYSTEMS; i++) {
+    this->intervals[i] = 1;
+    this->durations[i] = 0;
+  }
+  this->commandDuration = 0;
+  this->ticks = 0;
+}
+
+/*
+ * Called once per tick.  Subsystems go first so that commands always get the final
+ * say over anything they require.
+ */
+void Scheduler::update() {
+  uint64_t start = timer::systemHighResolution();
+  for(int32_t i = 0; i < this->subsystemCount; i++) {
+    this->durations[i] = 0;
+    if(this->ticks % this->intervals[i] != 0 || this->isRequired(this->subsystems[i])) continue;
+    this->subsystems[i]->update();
+    uint64_t end = timer::systemHighResolution();
+    this->durations[i] = (uint32_t) (end - start);
+    start = end;
+  }
+  this->ticks++;
+
+  start = timer::systemHighResolution();
+  for(int32_t i = 0; i < _SCHEDULER_H_MAX_COMMANDS; i++) {
+    Command* command = this->commands[i];
+    if(command == nullptr) continue;
+    command->execute();
+    // A command may have been cancelled from inside another command's `execute()`.
+    if(this->commands[i] == command && command->isFinished()) this->finish(i, false);
+  }
+  this->commandDuration = (uint32_t) (timer::systemHighResolution() - start);
+}
+
+bool Scheduler::schedule(Command* command) {
+  if(command == nullptr || this->isScheduled(command)) return false;
+
+  // First pass: make sure nothing we would have to interrupt outranks the new command,
+  // and that there will be a free slot once the conflicting commands are gone.
+  int32_t freeSlot = -1;
+  for(int32_t i = 0; i < _SCHEDULER_H_MAX_COMMANDS; i++) {
+    Command* running = this->commands[i];
+    if(running == nullptr || running->conflictsWith(command)) {
+      if(running != nullptr && running->getPriority() > command->getPriority()) return false;
+      if(freeSlot < 0) freeSlot = i;
+    }
+  }
+  if(freeSlot < 0) return false;
+
+  // Second pass: actually interrupt the conflicting commands.
+  for(int32_t i = 0; i < _SCHEDULER_H_MAX_COMMANDS; i++) {
+    if(this->commands[i] != nullptr && this->commands[i]->conflictsWith(command)) {
+      this->finish(i, true);
+    }
+  }
+
+  this->commands[freeSlot] = command;
+  command->initialize();
+  return true;
+}
+
+void Scheduler::cancel(Command* command) {
+  for(int32_t i = 0; i < _SCHEDULER_H_MAX_COMMANDS; i++) {
+    if(command != nullptr && this->commands[i] == command) this->finish(i, true);
+  }
+}
+
+void Scheduler::cancelAll() {
+  for(int32_t i = 0; i < _SCHEDULER_H_MAX_COMMANDS; i++) {
+    if(this->commands[i] != nullptr) this->finish(i, true);
+  }
+}
+
+bool Scheduler::isScheduled(const Command* command) const {
+  if(command == nullptr) return false;
+  for(int32_t i = 0; i < _SCHEDULER_H_MAX_COMMANDS; i++) {
+    if(this->commands[i] == command) return true;
+  }
+  return false;
+}
+
+bool Scheduler::isRequired(Subsystem* subsystem) const {
+  for(int32_t i = 0; i < _SCHEDULER_H_MAX_COMMANDS; i++) {
+    if(this->commands[i] != nullptr && this->commands[i]->hasRequirement(subsystem)) return true;
+  }
+  return false;
+}
+
+void Scheduler::setInterval(Subsystem* subsystem, int32_t ticks) {
+  for(int32_t i = 0; i < this->subsystemCount; i++) {
+    if(this->subsystems[i] == subsystem) this->intervals[i] = ticks < 1 ? 1 : ticks;
+  }
+}
+
+int32_t Scheduler::getSubsystemCount() const {
+  return this->subsystemCount;
+}
+
+Subsystem* Scheduler::getSubsystem(int32_t index) const {
+  return this->subsystems[index];
+}
+
+uint32_t Scheduler::getDuration(int32_t index) const {
+  return this->durations[index];
+}
+
+uint32_t Scheduler::getCommandDuration() const {
+  return this->commandDuration;
+}
+
+/*
+ * The slot is cleared before `end()` runs, so a command that schedules a follow-up
+ * from its own `end()` doesn't see itself as still running.
+ */
+void Scheduler::finish(int32_t index, bool interrupted) {
+  Command* command = this->commands[index];
+  this->commands[index] = nullptr;
+  command->end(interrupted);
+  command->release();
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "commands/ScoreCommand.h"
+#include "MessageQueue.h"
+
+ScoreCommand::ScoreCommand( MecanumDriveTank* drive,
+                            RD4BLift* lift,
+                            RollerIntake* intake,
+                            RD4BLift::State tower ) {
+  this->drive = drive;
+  this->lift = lift;
+  this->intake = intake;
+  this->tower = tower;
+  this->phase = Phase::RAISE;
+  this->driveStart = 0;
+  this->rollerStart = 0;
+  this->addRequirement(drive);
+  this->addRequirement(lift);
+  this->addRequirement(intake);
+}
+
+void ScoreCommand::initialize() {
+  controllerMessages.post(3, "Scoring...");
+  this->enter(Phase::RAISE);
+}
+
+void ScoreCommand::enter(Phase phase) {
+  this->phase = phase;
+  this->driveStart = this->drive->getDistance();
+  this->rollerStart = this->intake->getRotation();
+  if(phase == Phase::RAISE) this->lift->setState(this->tower);
+  if(phase == Phase::LOWER) this->lift->setState(RD4BLift::State::GROUND);
+}
+
+/*
+ * One tick of whichever phase we're in.  Each phase sets every subsystem it uses on
+ * every tick, then checks whether it is done; the next phase starts on the next tick.
+ */
+void ScoreCommand::execute() {
+  double driven = this->drive->getDistance() - this->driveStart;
+  this->lift->runState();
+
+  switch(this->phase) {
+    case Phase::RAISE:
+      this->drive->stop(brakeType::brake);
+      this->intake->spin(0);
+      if(this->lift->atTarget()) this->enter(Phase::APPROACH);
+      break;
+
+    case Phase::APPROACH:
+      this->drive->drive(_SCORECOMMAND_H_APPROACH_POWER, 0, 0);
+      this->intake->spin(0);
+      // Stopped against the tower, or gone as far as it could possibly be.
+      if((driven >= _SCORECOMMAND_H_APPROACH_START && this->drive->isStopped())
+         || driven >= _SCORECOMMAND_H_APPROACH_DISTANCE) {
+        this->enter(Phase::RELEASE);
+      }
+      break;
+
+    case Phase::RELEASE: {
+      this->drive->stop(brakeType::brake);
+      this->intake->spin(-_SCORECOMMAND_H_RELEASE_POWER);
+      double turned = this->rollerStart - this->intake->getRotation();
+      double speed = -this->intake->getSpeed();
+      if(turned >= _SCORECOMMAND_H_RELEASE_TURNS
+         && speed >= _SCORECOMMAND_H_RELEASE_POWER * _SCORECOMMAND_H_RELEASE_FREE / 100) {
+        this->enter(Phase::LOWER);
+      }
+      break;
+    }
+
+    case Phase::LOWER:
+      this->intake->spin(0);
+      if(driven > -_SCORECOMMAND_H_BACK_OFF_DISTANCE) {
+        this->drive->drive(-_SCORECOMMAND_H_BACK_OFF_POWER, 0, 0);
+      } else {
+        this->drive->stop(brakeType::brake);
+        if(this->lift->atTarget()) this->phase = Phase::DONE;
+      }
+      break;
+
+    case Phase::DONE:
+      break;
+  }
+}
+
+bool ScoreCommand::isFinished() {
+  return this->phase == Phase::DONE;
+}
+
+void ScoreCommand::end(bool interrupted) {
+  this->drive->stop(brakeType::coast);
+  this->intake->spin(0);
+  controllerMessages.post(3, interrupted ? "Score cancelled" : "Scored");
+}
+
+ScoreCommand::Phase ScoreCommand::getPhase() {
+  return this->phase;
+}
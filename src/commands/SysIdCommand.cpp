@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "commands/SysIdCommand.h"
+#include "commands/CommandPool.h"
+#include "commands/CommandGroup.h"
+#include "commands/LiftCommand.h"
+#include "commands/WaitUntilCommand.h"
+#include "Config.h"
+#include "MessageQueue.h"
+
+// The next test starts once the mechanism is below this speed (percent).
+#define REST_SPEED 1
+
+SysIdCommand::SysIdCommand(SysId* sysid, SysId::Test test) {
+  this->sysid = sysid;
+  this->test = test;
+  this->direction = (test == SysId::Test::RAMP_BACKWARD || test == SysId::Test::STEP_BACKWARD) ? -1 : 1;
+  this->start = 0;
+  this->done = false;
+  this->addRequirement(sysid->getSubsystem());
+}
+
+void SysIdCommand::initialize() {
+  static const char* names[] = { "ramp fwd", "ramp back", "step fwd", "step back" };
+  controllerMessages.post(3, "SysId: %s", names[this->test]);
+  this->start = this->sysid->getPosition();
+  this->elapsed.clear();
+  this->done = this->outOfRange();
+  if(!this->done) this->sysid->begin(this->test);
+}
+
+void SysIdCommand::execute() {
+  if(this->done) return;
+
+  bool drive = this->sysid->getMechanism() == SysId::Mechanism::DRIVE;
+  bool ramp = this->test == SysId::Test::RAMP_FORWARD || this->test == SysId::Test::RAMP_BACKWARD;
+  double time = this->elapsed.time(msec);
+  uint32_t timeout = ramp ? _SYSIDCOMMAND_H_RAMP_TIMEOUT : _SYSIDCOMMAND_H_STEP_TIMEOUT;
+
+  if(this->outOfRange() || time >= timeout || this->sysid->isFull()) {
+    this->sysid->stop();
+    this->done = true;
+    return;
+  }
+
+  double volts;
+  if(ramp) volts = (drive ? _SYSIDCOMMAND_H_DRIVE_RAMP : _SYSIDCOMMAND_H_LIFT_RAMP) * time / 1000;
+  else volts = drive ? _SYSIDCOMMAND_H_DRIVE_STEP : _SYSIDCOMMAND_H_LIFT_STEP;
+
+  if(this->test == SysId::Test::RAMP_FORWARD) {
+    // Note the first voltage that gets the lift moving, going by the last tick's speed.
+    if(!drive && this->sysid->getHoldVoltage() == 0
+       && this->sysid->getSpeed() >= _SYSIDCOMMAND_H_BREAKAWAY) {
+      this->sysid->setHoldVoltage(volts);
+    }
+    this->sysid->apply(volts);
+  } else {
+    this->sysid->apply(this->sysid->getHoldVoltage() + this->direction * volts);
+  }
+}
+
+bool SysIdCommand::outOfRange() {
+  double position = this->sysid->getPosition();
+  if(this->sysid->getMechanism() == SysId::Mechanism::DRIVE) {
+    return this->direction * (position - this->start) >= _SYSIDCOMMAND_H_DRIVE_DISTANCE;
+  }
+  double speed = this->sysid->getSpeed();
+  if(speed > _SYSIDCOMMAND_H_LIFT_SPEED || speed < -_SYSIDCOMMAND_H_LIFT_SPEED) return true;
+  // The same limits the lift itself is using, which need not be `activeConfig`'s.
+  const Config* config = this->sysid->getSubsystem()->getConfig();
+  if(this->direction > 0) return position >= config->liftUpperTower - _SYSIDCOMMAND_H_LIFT_MARGIN;
+  return position <= config->liftFloor + _SYSIDCOMMAND_H_LIFT_MARGIN;
+}
+
+bool SysIdCommand::isFinished() {
+  return this->done;
+}
+
+void SysIdCommand::end(bool interrupted) {
+  this->sysid->stop();
+  this->sysid->end();
+  if(interrupted) controllerMessages.post(3, "SysId cancelled");
+}
+
+// Storage for every command in the characterization below.
+static CommandPool<SysIdCommand, SysId::Test::TEST_COUNT> testPool;
+static CommandPool<WaitUntilCommand, SysId::Test::TEST_COUNT - 1> restPool;
+static CommandPool<LiftCommand, 1> liftPool;
+static CommandPool<SequentialGroup, 1> sequentialPool;
+
+/*
+ * Both mechanisms start from the floor: the drive base so that nothing can tip it over,
+ * and the lift so that it has all of its range to go up in.  The tests then alternate
+ * direction, so each one starts roughly where the last one left the mechanism.
+ *
+ * That is one lift move and four tests with a wait between each, which exactly fills a
+ * group (_COMMANDGROUP_H_MAX_COMMANDS).
+ */
+Command* buildCharacterization(SysId* sysid, RD4BLift* lift) {
+  SequentialGroup* routine = sequentialPool.acquire();
+  if(routine == nullptr) return nullptr;
+
+  sysid->clear();
+  auto resting = [sysid]() -> bool {
+    double speed = sysid->getSpeed();
+    return speed < REST_SPEED && speed > -REST_SPEED;
+  };
+
+  bool built = routine->add(liftPool.acquire(lift, RD4BLift::State::GROUND));
+  for(int32_t test = 0; test < SysId::Test::TEST_COUNT; test++) {
+    if(test > 0) built = routine->add(restPool.acquire(resting)) && built;
+    built = routine->add(testPool.acquire(sysid, (SysId::Test) test)) && built;
+  }
+  if(!built) {
+    routine->release();
+    return nullptr;
+  }
+  return routine;
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2019 Brandon Gong
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "commands/TrajectoryCommand.h"
+
+TrajectoryCommand::TrajectoryCommand(MecanumDriveTank* drive, const Trajectory* trajectory) {
+  this->drive = drive;
+  this->trajectory = trajectory;
+  for(int i = 0; i < 4; i++) this->start[i] = this->errors[i] = 0;
+  this->target = sampleTrajectory(*trajectory, 0);
+  this->addRequirement(drive);
+}
+
+void TrajectoryCommand::initialize() {
+  this->drive->getWheelPositions(this->start);
+  this->elapsed.clear();
+}
+
+void TrajectoryCommand::execute() {
+  this->target = sampleTrajectory(*this->trajectory, this->elapsed.time(msec));
+
+  double positions[4];
+  this->drive->getWheelPositions(positions);
+  for(int i = 0; i < 4; i++) {
+    this->errors[i] = this->target.wheelPosition[i] - (positions[i] - this->start[i]);
+  }
+  this->drive->followWheels(this->target.wheelSpeed, this->target.wheelAcceleration, this->errors);
+}
+
+bool TrajectoryCommand::isFinished() {
+  double late = this->elapsed.time(msec) - this->trajectory->duration();
+  if(late < 0) return false;
+  if(late >= _TRAJECTORYCOMMAND_H_SETTLE_TIME) return true;
+  for(double error : this->errors) {
+    if(error > _TRAJECTORYCOMMAND_H_TOLERANCE || error < -_TRAJECTORYCOMMAND_H_TOLERANCE) return false;
+  }
+  return true;
+}
+
+void TrajectoryCommand::end(bool interrupted) {
+  this->drive->stop(brakeType::brake);
+}
+
+const TrajectorySample& TrajectoryCommand::getTarget() {
+  return this->target;
+}
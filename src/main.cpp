@@ -24,11 +24,38 @@
 #include "subsystems/MecanumDriveTank.h"
 #include "subsystems/RD4BLift.h"
 #include "subsystems/RollerIntake.h"
+#include "commands/Scheduler.h"
+#include "commands/CommandPool.h"
+#include "commands/ScoreCommand.h"
+#include "commands/SysIdCommand.h"
+#include "Autonomous.h"
+#include "Config.h"
+#include "Dashboard.h"
+#include "MessageQueue.h"
+#include "Watchdog.h"
+#include "LatencyProbe.h"
+#include "SysId.h"
+#include "RobotState.h"
+#include "Sensing.h"
+#include "Startup.h"
+#include "Logger.h"
+#include <atomic>
 
 using namespace vex;
 
 #define IS_COMPETITION 1
 
+// Time between ticks of the control loop, in milliseconds.
+#define CONTROL_PERIOD 25
+
+// Measure stick-to-motor latency on the left drive stick, and print it to the terminal.
+#define MEASURE_LATENCY 0
+
+// Characterize one mechanism when RIGHT and X are pressed together in driver control,
+// and save the log to the SD card for host/tools/sysid to fit.
+#define RUN_SYSID 0
+#define SYSID_MECHANISM SysId::Mechanism::DRIVE
+
 // Convenience preprocessor defs for wrapping controller inputs in lambda functions
 // Need this to pass inputs to subsystems
 #define AxisInput(x)   ([&]() -> int32_t {return joystick.x.position();})
@@ -36,19 +63,61 @@ using namespace vex;
 
 Subsystem* subsystems[3];
 
+// Typed handles on the same subsystems, for building autonomous commands.
+MecanumDriveTank* drive;
+RD4BLift* lift;
+RollerIntake* intake;
+
+// Runs commands on top of the subsystems, and updates whichever subsystems aren't in use.
+Scheduler scheduler(subsystems, 3);
+
+// Times every tick, and sheds optional work if the loop keeps running over.
+Watchdog watchdog(&scheduler);
+
+/*
+ * Everything besides the control loop runs in its own task, at a lower priority, and
+ * only talks to the control loop through `controlState` and `sensorState`:
+ *
+ *    control    high     fixed-rate tick of the scheduler, publishes controlState
+ *    sensing    medium   samples the battery and motors, publishes sensorState
+ *    logging    low      writes both states to the SD card
+ *    dashboard  low      draws both states on the Brain screen
+ *    messages   low      sends controller text and rumbles
+ *    reload     low      reads config.txt again when the driver asks for it
+ *    setup      medium   one per step in `startup`, gone before the first tick
+ */
+Sensing sensing;
+Logger logger;
+Dashboard dashboard;
+
+// Setup steps that have to finish before the first tick, run side by side.
+Startup startup;
+
+// What the control task should be doing.  The competition callbacks only ask for a
+// mode; the control task makes the switch at the start of its next tick, so it is the
+// only task that ever touches the scheduler.
+enum Mode { DISABLED, AUTONOMOUS, DRIVER };
+std::atomic<Mode> requestedMode(DISABLED);
+
+// The scoring macro started from the controller, if there is one.  `scorePool` only
+// has the one slot, so there is never more than one macro running at a time.
+CommandPool<ScoreCommand, 1> scorePool;
+ScoreCommand* macro = nullptr;
+
+#if MEASURE_LATENCY
+LatencyProbe* probe;
+#endif
+
+#if RUN_SYSID
+SysId* sysid;
+// Set by the control task once a characterization is over, for the main task to save.
+std::atomic<bool> sysidFinished(false);
+#endif
+
 // Global controller instance.
 controller joystick = controller(primary);
 competition Competition;
 
-// TODO clean competition junk
-motor fl(FRONT_LEFT_MOTOR_PORT),
-      fr(FRONT_RIGHT_MOTOR_PORT),
-      bl(BACK_LEFT_MOTOR_PORT),
-      br(BACK_RIGHT_MOTOR_PORT),
-      il(ROLLER_LEFT_MOTOR_PORT),
-      ir(ROLLER_RIGHT_MOTOR_PORT);
-
-
 // Convert the up and down inputs (button inputs) into one axis input.
 int32_t updownAxisInput() {
   int32_t power = 75;
@@ -67,102 +136,228 @@ int32_t yaAxisInput() {
   else return -power;
 };
 
-void teleop() {
-  // Continuously update all of the subsystems in the `subsystems` array
+/*
+ * Reading and parsing config.txt can take longer than a tick, so it happens in a
+ * low-priority task.  The control task asks for a reload, the reload task parses into
+ * `loadedConfig`, and the control task swaps that in between two ticks.  Each side
+ * only moves `reload` on from the states it owns, so `loadedConfig` is never read and
+ * written at once.
+ *
+ * The load at startup goes the same way, from the "config" setup step: `reload` starts
+ * out as LOADING, which belongs to that step.  So if the control task starts without
+ * it, the constants it finds still only change between two ticks.
+ */
+enum Reload { IDLE, REQUESTED, LOADING, LOADED };
+std::atomic<Reload> reload(LOADING);
+Config loadedConfig;
+int32_t loadedCount;
+// Whether to tell the driver once the constants are swapped in.  The load at startup
+// is covered by the "Ready" message instead.
+bool announceLoad;
+
+// Ask for the configuration to be reloaded from the SD card when LEFT and X are pressed
+// together, so constants can be changed between matches without downloading the
+// program again.
+void checkConfigReload() {
+  static bool wasPressed = false;
+  bool pressed = joystick.ButtonLeft.pressing() && joystick.ButtonX.pressing();
+  Reload idle = IDLE;
+  if(pressed && !wasPressed) reload.compare_exchange_strong(idle, REQUESTED);
+  wasPressed = pressed;
+}
+
+// Swap in a configuration the reload task has finished with, if there is one.
+void swapConfig() {
+  if(reload.load() != LOADED) return;
+  activeConfig = loadedConfig;
+  if(announceLoad) controllerMessages.post(3, "Config: %d values", (int) loadedCount);
+  reload = IDLE;
+}
+
+// The reload task.
+int reloadConfig() {
   while(true) {
-    for(Subsystem* subsystem : subsystems) subsystem->update();
-    wait(25, msec);
+    Reload requested = REQUESTED;
+    if(reload.compare_exchange_strong(requested, LOADING)) {
+      loadedCount = loadedConfig.load();
+      announceLoad = true;
+      if(loadedCount < 0) {
+        controllerMessages.post(3, "No config file");
+        reload = IDLE;
+      } else {
+        reload = LOADED;
+      }
+    }
+    task::sleep(CONTROL_PERIOD);
+  }
+  return 0;
+}
+
+// Whether the driver is touching any of the manual controls.
+bool manualInput() {
+  int32_t deadband = activeConfig.driveDeadband;
+  return abs(joystick.Axis3.position()) > deadband
+      || abs(joystick.Axis2.position()) > deadband
+      || joystick.ButtonL1.pressing() || joystick.ButtonL2.pressing()
+      || joystick.ButtonR1.pressing() || joystick.ButtonR2.pressing()
+      || joystick.ButtonA.pressing() || joystick.ButtonY.pressing()
+      || joystick.ButtonB.pressing();
+}
+
+// Start a scoring macro on DOWN (lower tower) or UP (upper tower), and hand control
+// straight back to the driver as soon as they touch anything else.
+void checkMacros() {
+  static bool wasDown = false, wasUp = false;
+  bool down = joystick.ButtonDown.pressing();
+  bool up = joystick.ButtonUp.pressing();
+
+  if(scheduler.isScheduled(macro)) {
+    if(manualInput()) scheduler.cancel(macro);
+  } else if((down && !wasDown) || (up && !wasUp)) {
+    RD4BLift::State tower = up ? RD4BLift::State::UPPER_TOWER : RD4BLift::State::LOWER_TOWER;
+    macro = scorePool.acquire(drive, lift, intake, tower);
+    if(!scheduler.schedule(macro) && macro != nullptr) macro->release();
+  }
+
+  wasDown = down;
+  wasUp = up;
+}
+
+#if RUN_SYSID
+// Start characterizing on RIGHT and X, and stop as soon as the driver touches anything
+// else, in case it is heading somewhere it shouldn't.
+void checkSysId() {
+  static bool wasPressed = false;
+  static Command* characterization = nullptr;
+  bool pressed = joystick.ButtonRight.pressing() && joystick.ButtonX.pressing();
+
+  if(scheduler.isScheduled(characterization)) {
+    if(manualInput()) scheduler.cancel(characterization);
+  } else {
+    if(characterization != nullptr) sysidFinished = true;
+    characterization = nullptr;
+    if(pressed && !wasPressed) {
+      characterization = buildCharacterization(sysid, lift);
+      if(!scheduler.schedule(characterization) && characterization != nullptr) {
+        characterization->release();
+        characterization = nullptr;
+      }
+    }
   }
+
+  wasPressed = pressed;
+}
+#endif
+
+// One pass of the control loop: update everything, check the timing, and publish the
+// result for the other tasks.
+void tick(bool enabled) {
+  static uint32_t ticks = 0;
+  static uint64_t lastStart = 0;
+
+  uint64_t start = timer::systemHighResolution();
+#if MEASURE_LATENCY
+  probe->tickStarted(start);
+#endif
+  scheduler.update();
+  uint64_t end = timer::systemHighResolution();
+#if MEASURE_LATENCY
+  probe->tickEnded(end);
+#endif
+  watchdog.check(start, end);
+
+  ControlState state;
+  state.time = timer::system();
+  state.ticks = ++ticks;
+  state.enabled = enabled;
+  state.liftState = lift->getState();
+  state.liftHeight = lift->getHeight();
+  state.driveDistance = drive->getDistance();
+  drive->getSlip(state.wheelSlip);
+  state.intakeJammed = intake->isJammed();
+  state.busy = (uint32_t) (end - start);
+  state.period = lastStart == 0 ? 0 : (uint32_t) (start - lastStart);
+  state.watchdogLevel = watchdog.getLevel();
+  state.overruns = watchdog.getOverrunCount();
+  state.overrunBy = state.overruns > 0 ? watchdog.getOverrun(0).offender : -1;
+  controlState.write(state);
+  lastStart = start;
+}
+
+// The control task.  Ticks every CONTROL_PERIOD, measured from when the last tick was
+// due rather than when it finished, so a slow tick doesn't push every later one back.
+int control() {
+  Mode mode = DISABLED;
+
+  // Nothing is commanded until the hardware and constants are ready, but autonomous
+  // still starts on time if some step never finishes.
+  if(startup.wait(_STARTUP_H_TIMEOUT)) {
+    controllerMessages.post(3, "Ready in %d ms", (int) startup.getElapsed());
+  } else {
+    controllerMessages.post(3, "Late: %s", startup.getPending());
+  }
+
+  uint32_t next = timer::system();
+
+  while(true) {
+    Mode requested = requestedMode.load();
+#if IS_COMPETITION
+    if(!Competition.isEnabled()) requested = DISABLED;
+#endif
+    if(requested != mode) {
+      // Drop anything left over from the last mode, so the driver has every subsystem
+      // and the autonomous pools are free for the next routine.
+      scheduler.cancelAll();
+      if(requested == AUTONOMOUS) scheduler.schedule(buildAutonomous(drive, lift, intake));
+      mode = requested;
+    }
+
+    swapConfig();
+    tick(mode != DISABLED);
+    if(mode == DRIVER) {
+      checkConfigReload();
+      checkMacros();
+#if RUN_SYSID
+      checkSysId();
+#endif
+    }
+
+    next += CONTROL_PERIOD;
+    int32_t remaining = (int32_t) (next - timer::system());
+    if(remaining > 0) task::sleep(remaining);
+    else next = timer::system();
+  }
+  return 0;
+}
+
+void teleop() {
+  requestedMode = DRIVER;
 }
 
-// todo clean
 void auton() {
-  fl.setVelocity(-50, percent);
-  fr.setVelocity(50, percent);
-  bl.setVelocity(-50, percent);
-  br.setVelocity(50, percent);
-  fl.spin(forward);
-  fr.spin(forward);
-  bl.spin(forward);
-  br.spin(forward);
-  task::sleep(2000);
-  fl.stop(brakeType::brake);
-  fr.stop(brakeType::brake);
-  bl.stop(brakeType::brake);
-  br.stop(brakeType::brake);
-  il.setVelocity(-50, percent);
-  ir.setVelocity(50, percent);
-  fl.setVelocity(20, percent);
-  fr.setVelocity(-20, percent);
-  bl.setVelocity(20, percent);
-  br.setVelocity(-20, percent);
-  fl.spin(forward);
-  fr.spin(forward);
-  bl.spin(forward);
-  br.spin(forward);
-  ir.spin(forward);
-  il.spin(forward);
-  task::sleep(3000);
-  fl.stop(brakeType::brake);
-  fr.stop(brakeType::brake);
-  bl.stop(brakeType::brake);
-  br.stop(brakeType::brake);
-  il.stop(brakeType::brake);
-  ir.stop(brakeType::brake);
-  task::sleep(300);
-  fl.setVelocity(-50, percent);
-  fr.setVelocity(50, percent);
-  bl.setVelocity(-50, percent);
-  br.setVelocity(50, percent);
-  fl.spin(forward);
-  fr.spin(forward);
-  bl.spin(forward);
-  br.spin(forward);
-  task::sleep(1250);
-  fl.stop(brakeType::brake);
-  fr.stop(brakeType::brake);
-  bl.stop(brakeType::brake);
-  br.stop(brakeType::brake);
-  task::sleep(300);
-  fl.setVelocity(50, percent);
-  fr.setVelocity(-50, percent);
-  bl.setVelocity(50, percent);
-  br.setVelocity(-50, percent);
-  fl.spin(forward);
-  fr.spin(forward);
-  bl.spin(forward);
-  br.spin(forward);
-  task::sleep(3000);
-  fl.stop(brakeType::brake);
-  fr.stop(brakeType::brake);
-  bl.stop(brakeType::brake);
-  br.stop(brakeType::brake);
-  task::sleep(300);
+  // The routine runs through the same tick as driver control, and is cancelled when
+  // the period ends and the robot is disabled.
+  requestedMode = AUTONOMOUS;
 }
 
 /**
  * Main entry point of the code.
  *
- * Initialize all subsystems we need (e.g. drivetrain, lift, intake), then continuously
- * update them until the program is interrupted.
+ * Initialize all subsystems we need (e.g. drivetrain, lift, intake), set off the setup
+ * steps, then start the control task and the tasks around it.
  */
 int main() {
 
-  // Initialize all of the subsystems.
-  subsystems[0] = 
+  // Initialize all of the subsystems.  The drive and lift go first so that they are
+  // never held up behind anything else within a tick.  The constructors don't touch
+  // the hardware; that happens in the setup steps below.
+  subsystems[0] = lift =
     new RD4BLift(
       updownAxisInput, // didn't have enough axes to work with, so this is bumper L1 and R1
       LIFT_LEFT_MOTOR_PORT,
       LIFT_RIGHT_MOTOR_PORT
     );
-  subsystems[1] = 
-    new RollerIntake(
-      ButtonInput(ButtonR1),
-      ButtonInput(ButtonR2),
-      ROLLER_LEFT_MOTOR_PORT,
-      ROLLER_RIGHT_MOTOR_PORT
-    );
-  subsystems[2] = 
+  subsystems[1] = drive =
     new MecanumDriveTank(
       AxisInput(Axis3),
       AxisInput(Axis2),
@@ -173,19 +368,100 @@ int main() {
       BACK_RIGHT_MOTOR_PORT,
       BACK_LEFT_MOTOR_PORT
     );
+  subsystems[2] = intake =
+    new RollerIntake(
+      ButtonInput(ButtonR1),
+      ButtonInput(ButtonR2),
+      ROLLER_LEFT_MOTOR_PORT,
+      ROLLER_RIGHT_MOTOR_PORT
+    );
+
+  // The drive base slows down as the lift goes up, so it can't tip the robot over.
+  drive->setLiftHeight([]() -> double { return lift->getHeight(); });
+
+  // The drive answers the sticks through its feedforward model.  The lift and intake
+  // stay in velocity mode until theirs have been measured.
+  drive->useFeedforward(true);
+
+  // Traction control stays off until it has been tuned on the robot: in
+  // host/tools/traction it costs a little progress everywhere and only pays off on
+  // slick floors.
+  drive->useTractionControl(false);
+
+  // The intake can fall back to a lower rate if the loop starts running over; the drive
+  // and lift always run every tick.
+  watchdog.setNonCritical(intake);
+
+  // Setup steps, each in its own task so that one waiting on the SD card or a device
+  // doesn't hold up the others.  Each one only touches its own hardware.  A gyro would
+  // be calibrated in a step of its own here; trajectories are compiled in, so there's
+  // nothing to load for them.
+  startup.add("config", []() {
+    // Pick up any constants saved on the SD card; otherwise the compiled defaults stand.
+    // The control task swaps them in before its first tick, or between two later ones
+    // if it had to start without this step.
+    loadedCount = loadedConfig.load();
+    announceLoad = false;
+    reload = loadedCount < 0 ? IDLE : LOADED;
+  });
+  startup.add("lift", []() { lift->prepare(); });
+  startup.add("drive", []() { drive->prepare(); });
+  startup.add("intake", []() { intake->prepare(); });
+  startup.start();
+
+  // Everything else runs at a lower priority, so it only gets whatever time the control
+  // loop leaves.
+  sensing.start();
+  logger.start();
+  dashboard.start();
+  controllerMessages.start(&joystick);
+  task(reloadConfig, task::taskPrioritylow);
+
+#if MEASURE_LATENCY
+  probe = new LatencyProbe(AxisInput(Axis3), FRONT_LEFT_MOTOR_PORT);
+  probe->start();
+  uint32_t nextReport = 32;
+#endif
+
+#if RUN_SYSID
+  if(SYSID_MECHANISM == SysId::Mechanism::DRIVE) sysid = new SysId(drive);
+  else sysid = new SysId(lift);
+  sysid->start();
+#endif
 
 #if IS_COMPETITION
   Competition.autonomous(auton);
   Competition.drivercontrol(teleop);
+#else
+  teleop();
+#endif
 
-  task::sleep(100);
+  task(control, task::taskPriorityHigh);
 
+  bool reported = false;
   while(1) {
     task::sleep(100);
-  }
-#else
-  teleop();
+    // Print the setup times once, when setup is over or has given up waiting.
+    if(!reported && (startup.isDone() || startup.getElapsed() >= _STARTUP_H_TIMEOUT)) {
+      startup.report();
+      reported = true;
+    }
+#if MEASURE_LATENCY
+    // Nothing else runs on this thread, so it may as well do the (slow) printing.
+    if(probe->getSampleCount() >= nextReport) {
+      probe->report();
+      nextReport += 32;
+    }
 #endif
+#if RUN_SYSID
+    // Also slow, and only once the tests are over so it can't hold them up.
+    if(sysidFinished.exchange(false)) {
+      int32_t saved = sysid->save();
+      if(saved < 0) controllerMessages.post(3, "SysId: no SD card");
+      else controllerMessages.post(3, "SysId: %d saved", (int) saved);
+    }
+#endif
+  }
 
   return 0;
 }
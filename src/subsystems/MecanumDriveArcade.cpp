@@ -21,6 +21,7 @@
  */
 
 #include "subsystems/MecanumDriveArcade.h"
+#include "Motors.h"
 
 /*
  * Assign all of the constructor parameters to the private internal variables,
@@ -29,10 +30,10 @@
  */
 MecanumDriveArcade::MecanumDriveArcade(AxisInput drive, AxisInput strafe, AxisInput twist,
                            int32_t fr, int32_t fl, int32_t br, int32_t bl) :
-  frontRight(fr),
-  frontLeft(fl),
-  backRight(br),
-  backLeft(bl) {
+  frontRight(Motors::get(fr)),
+  frontLeft(Motors::get(fl)),
+  backRight(Motors::get(br)),
+  backLeft(Motors::get(bl)) {
   this->driveAxis = drive;
   this->strafeAxis = strafe;
   this->twistAxis = twist;
@@ -44,10 +45,10 @@ MecanumDriveArcade::MecanumDriveArcade(AxisInput drive, AxisInput strafe, AxisIn
  * TODO: if we do anything autonomous, encoders should be reset here
  */
 MecanumDriveArcade::MecanumDriveArcade(AxisInput inputs[3], motor motors[4]) :
-  frontRight(motors[0]),
-  frontLeft(motors[1]),
-  backRight(motors[2]),
-  backLeft(motors[3]) {
+  frontRight(Motors::get(motors[0].index())),
+  frontLeft(Motors::get(motors[1].index())),
+  backRight(Motors::get(motors[2].index())),
+  backLeft(Motors::get(motors[3].index())) {
   driveAxis = inputs[0];
   strafeAxis = inputs[1];
   twistAxis = inputs[2];
@@ -65,9 +66,9 @@ void MecanumDriveArcade::update() {
   int32_t twistPower  = this->twistAxis();
 
   // Apply deadband (zero out input if it is less than the deadband)
-  drivePower  = (abs(drivePower) > _MDA_H_DEADBAND) ? drivePower : 0;
-  strafePower = (abs(strafePower) > _MDA_H_DEADBAND) ? strafePower : 0;
-  twistPower  = (abs(twistPower) > _MDA_H_DEADBAND) ? twistPower : 0;
+  drivePower  = (abs(drivePower) > this->config->arcadeDeadband) ? drivePower : 0;
+  strafePower = (abs(strafePower) > this->config->arcadeDeadband) ? strafePower : 0;
+  twistPower  = (abs(twistPower) > this->config->arcadeDeadband) ? twistPower : 0;
 
   // Apply cubic interpolation if needed.  TODO: tweak so the deadband doesn't grow as well
   if(_MDA_H_CUBIC_DRIVE) {
@@ -21,46 +21,59 @@
  */
 
 #include "subsystems/MecanumDriveTank.h"
+#include "Compensation.h"
+#include "Motors.h"
 
 /*
  * Assign all of the constructor parameters to the private internal variables,
- * either via direct assignment or the copy constructor.
- * TODO: if we do anything autonomous, encoders should be reset here
+ * either via direct assignment or the copy constructor.  The motors are set up
+ * in `prepare()`.
  */
 MecanumDriveTank::MecanumDriveTank(AxisInput lDrive, AxisInput rDrive, AxisInput strafe, ButtonInput halfDrive,
                            int32_t fr, int32_t fl, int32_t br, int32_t bl) :
-  frontRight(fr),
-  frontLeft(fl),
-  backRight(br),
-  backLeft(bl) {
+  frontRight(Motors::get(fr)),
+  frontLeft(Motors::get(fl)),
+  backRight(Motors::get(br)),
+  backLeft(Motors::get(bl)) {
   this->lDriveAxis = lDrive;
   this->rDriveAxis = rDrive;
   this->strafeAxis = strafe;
   this->halfDrive = halfDrive;
-  this->frontRight.setBrake(brakeType::coast);
-  this->frontLeft.setBrake(brakeType::coast);
-  this->backRight.setBrake(brakeType::coast);
-  this->backLeft.setBrake(brakeType::coast);
+  this->traction = false;
+  for(int i = 0; i < 4; i++) {
+    this->lastPowers[i] = this->references[i] = 0;
+    this->groundSpeeds[i] = this->slips[i] = 0;
+    this->shares[i] = 1;
+  }
 };
 
 /*
  * Assign all of the constructor parameters to the private internal variables,
  * either via direct assignment or the copy constructor.
- * TODO: if we do anything autonomous, encoders should be reset here
  */
 MecanumDriveTank::MecanumDriveTank(AxisInput inputs[3], motor motors[4]) :
-  frontRight(motors[0]),
-  frontLeft(motors[1]),
-  backRight(motors[2]),
-  backLeft(motors[3]) {
+  frontRight(Motors::get(motors[0].index())),
+  frontLeft(Motors::get(motors[1].index())),
+  backRight(Motors::get(motors[2].index())),
+  backLeft(Motors::get(motors[3].index())) {
   lDriveAxis = inputs[0];
   rDriveAxis = inputs[1];
   strafeAxis = inputs[2];
+  this->traction = false;
+  for(int i = 0; i < 4; i++) {
+    this->lastPowers[i] = this->references[i] = 0;
+    this->groundSpeeds[i] = this->slips[i] = 0;
+    this->shares[i] = 1;
+  }
+};
+
+void MecanumDriveTank::prepare() {
   this->frontRight.setBrake(brakeType::coast);
   this->frontLeft.setBrake(brakeType::coast);
   this->backRight.setBrake(brakeType::coast);
   this->backLeft.setBrake(brakeType::coast);
-};
+  this->resetDistance();
+}
 
 void MecanumDriveTank::update() {
 
@@ -71,9 +84,9 @@ void MecanumDriveTank::update() {
   int32_t strafePower = this->strafeAxis();
 
   // Apply deadband (zero out input if it is less than the deadband)
-  lDrivePower  = (abs(lDrivePower) > _MDT_H_DEADBAND) ? lDrivePower : 0;
-  rDrivePower  = (abs(rDrivePower) > _MDT_H_DEADBAND) ? rDrivePower : 0;
-  strafePower = (abs(strafePower) > _MDT_H_DEADBAND) ? strafePower : 0;
+  lDrivePower  = (abs(lDrivePower) > this->config->driveDeadband) ? lDrivePower : 0;
+  rDrivePower  = (abs(rDrivePower) > this->config->driveDeadband) ? rDrivePower : 0;
+  strafePower = (abs(strafePower) > this->config->driveDeadband) ? strafePower : 0;
 
   // Apply cubic
   lDrivePower = lDrivePower * lDrivePower * lDrivePower / 10000;
@@ -91,6 +104,20 @@ void MecanumDriveTank::update() {
   int32_t drivePower = (lDrivePower + rDrivePower) * 0.5;
   int32_t twistPower = (lDrivePower - rDrivePower) * 0.5;
 
+  this->setMotorPowers(drivePower, twistPower, strafePower);
+}
+
+/*
+ * The mixer's "drive" and "twist" are named after the tank sticks rather than how the
+ * robot moves: with the right-side motors not reversed, pushing both sticks forward
+ * comes out as twist, and pushing them in opposite directions comes out as drive.
+ */
+void MecanumDriveTank::drive(int32_t forward, int32_t strafe, int32_t turn) {
+  this->setMotorPowers(turn, forward, strafe);
+}
+
+void MecanumDriveTank::setMotorPowers(int32_t drivePower, int32_t twistPower, int32_t strafePower) {
+
   // Calculate the power of each motor based on the drive, strafe, and twist powers,
   // in the order front-left, front-right, back-left, back-right.
   int32_t motorPowers[] = {
@@ -113,15 +140,222 @@ void MecanumDriveTank::update() {
     }
   }
 
-  // Set calculated speeds on the motors.
-  this->frontLeft.setVelocity(motorPowers[0], percent);
-  this->frontRight.setVelocity(motorPowers[1], percent);
-  this->backLeft.setVelocity(motorPowers[2], percent);
-  this->backRight.setVelocity(motorPowers[3], percent);
+  // Hold the wheels to the top speed and acceleration allowed at the lift's height.
+  // The top speed scales every wheel by the same amount, so the robot still goes in
+  // the direction asked for, just slower.
+  if(this->liftHeight) {
+    const DriveLimit& limit = this->config->driveLimit(this->liftHeight());
+    int32_t fastest = 0;
+    for(int32_t motorPower : motorPowers) {
+      if(abs(motorPower) > fastest) fastest = abs(motorPower);
+    }
+    for(int i = 0; i < 4; i++) {
+      if(fastest > limit.speed) motorPowers[i] = motorPowers[i] * limit.speed / fastest;
+      int32_t change = motorPowers[i] - this->lastPowers[i];
+      if(change > limit.accel) motorPowers[i] = this->lastPowers[i] + limit.accel;
+      if(change < -limit.accel) motorPowers[i] = this->lastPowers[i] - limit.accel;
+    }
+  }
+
+  // Work out the output for each wheel, then set it once traction control has had its say.
+  double dt = this->outputInterval();
+  double volts[4];
+  for(int i = 0; i < 4; i++) {
+    volts[i] = this->outputVolts(this->config->driveModel, motorPowers[i], this->references[i], dt);
+    this->lastPowers[i] = motorPowers[i];
+  }
+  if(this->traction) {
+    double powers[4] = { (double) motorPowers[0], (double) motorPowers[1],
+                         (double) motorPowers[2], (double) motorPowers[3] };
+    this->measureSlip(powers, dt);
+    this->limitSlip(volts);
+  }
+
+  // With nothing asked of any wheel, brake to a stop the way zero velocity used to,
+  // rather than sending 0V and coasting.
+  if(motorPowers[0] == 0 && motorPowers[1] == 0 && motorPowers[2] == 0 && motorPowers[3] == 0) {
+    this->stop(brakeType::brake);
+    return;
+  }
+  motor* motors[] = { &this->frontLeft, &this->frontRight, &this->backLeft, &this->backRight };
+  for(int i = 0; i < 4; i++) this->spinOutput(*motors[i], volts[i]);
+}
+
+/*
+ * The commanded wheel speeds say which way the robot should be going; the measured
+ * ones say how far along that it has got.  Each wheel's speed over its command gives
+ * one estimate of that, and the median of them is one that a single wheel spinning
+ * out of step with the rest can't move much.  Scaled back up by each command, that
+ * is the speed each wheel would turn at if it gripped.
+ *
+ * When all four wheels break loose together (a hard start), they agree with each
+ * other, so the ground speed is also held to what the carpet could have done since
+ * the last tick.
+ */
+void MecanumDriveTank::measureSlip(const double powers[4], double dt) {
+  motor* motors[] = { &this->frontLeft, &this->frontRight, &this->backLeft, &this->backRight };
+  double speeds[4], ratios[4];
+  int32_t count = 0;
+  for(int i = 0; i < 4; i++) {
+    speeds[i] = motors[i]->velocity(velocityUnits::pct);
+    if(fabs(powers[i]) >= _MDT_H_TRACTION_FLOOR) ratios[count++] = speeds[i] / powers[i];
+  }
+  for(int i = 1; i < count; i++) {
+    for(int j = i; j > 0 && ratios[j - 1] > ratios[j]; j--) {
+      double swap = ratios[j];
+      ratios[j] = ratios[j - 1];
+      ratios[j - 1] = swap;
+    }
+  }
+  double progress = 0;
+  if(count > 0) progress = (ratios[(count - 1) / 2] + ratios[count / 2]) / 2;
+
+  double step = this->config->tractionAccel * dt;
+  for(int i = 0; i < 4; i++) {
+    // With nothing commanded, the wheel's own speed is the best guess there is.
+    double ground = count > 0 ? progress * powers[i] : speeds[i];
+    double last = this->groundSpeeds[i];
+    if(ground > last + step) ground = last + step;
+    if(ground < last - step) ground = last - step;
+    this->groundSpeeds[i] = ground;
+
+    double scale = fmax(fmax(fabs(speeds[i]), fabs(ground)), _MDT_H_TRACTION_FLOOR);
+    this->slips[i] = (speeds[i] - ground) / scale * (speeds[i] < 0 ? -1 : 1);
+  }
+}
+
+/*
+ * A wheel's torque comes from the voltage beyond what it takes to turn at its ground
+ * speed.  A slipping wheel has that cut by a share each tick, down to
+ * _MDT_H_TRACTION_MIN, and given back a share at a time once it grips again.
+ *
+ * Through the mixer, more drive on the front wheels and less on the back (with the
+ * right side reversed, as it is here) adds up to no motion at all, so drive can be
+ * moved along that pattern without changing where the robot goes.  It is moved as
+ * far as gets the held-back wheels closest to what they are allowed; whatever that
+ * can't take off them comes off anyway, since they can't deliver it.  If all four
+ * slip together there is nowhere to move it to, and they are simply cut.
+ */
+void MecanumDriveTank::limitSlip(double volts[4]) {
+  static const double balance[4] = { +1, +1, -1, -1 };
+  double holding[4], allowed[4];
+  double shift = 0;
+  int32_t held = 0;
+  for(int i = 0; i < 4; i++) {
+    // Cut from what the motor can actually be given; the model can ask for more.
+    volts[i] = fmax(-_COMPENSATION_H_FULL_SCALE, fmin(_COMPENSATION_H_FULL_SCALE, volts[i]));
+    if(fabs(this->slips[i]) > this->config->tractionSlip) {
+      this->shares[i] = fmax(this->shares[i] - _MDT_H_TRACTION_CUT, _MDT_H_TRACTION_MIN);
+    } else {
+      this->shares[i] = fmin(this->shares[i] + _MDT_H_TRACTION_RECOVER, 1);
+    }
+    double ground = this->groundSpeeds[i];
+    holding[i] = this->feedforward ? this->config->driveModel.volts(ground, 0)
+                                   : ground * _COMPENSATION_H_FULL_SCALE / 100;
+    allowed[i] = holding[i] + this->shares[i] * (volts[i] - holding[i]);
+    if(this->shares[i] < 1) {
+      shift += balance[i] * (allowed[i] - volts[i]);
+      held++;
+    }
+  }
+  if(held == 0) return;
+  shift /= held;
+
+  for(int i = 0; i < 4; i++) {
+    double output = volts[i] + balance[i] * shift;
+    if(this->shares[i] < 1 && fabs(output - holding[i]) > fabs(allowed[i] - holding[i])) output = allowed[i];
+    volts[i] = fmax(-_COMPENSATION_H_FULL_SCALE, fmin(_COMPENSATION_H_FULL_SCALE, output));
+  }
+}
+
+void MecanumDriveTank::stop(brakeType mode) {
+  for(int i = 0; i < 4; i++) this->lastPowers[i] = this->references[i] = 0;
+  this->frontLeft.stop(mode);
+  this->frontRight.stop(mode);
+  this->backLeft.stop(mode);
+  this->backRight.stop(mode);
+}
+
+/*
+ * Right-side encoders count backwards when driving forwards (same reason as in
+ * `drive()`), so they are subtracted.
+ */
+double MecanumDriveTank::getDistance() {
+  return ( this->frontLeft.position(rotationUnits::rev)
+         - this->frontRight.position(rotationUnits::rev)
+         + this->backLeft.position(rotationUnits::rev)
+         - this->backRight.position(rotationUnits::rev) ) / 4;
+}
+
+void MecanumDriveTank::resetDistance() {
+  this->frontLeft.resetPosition();
+  this->frontRight.resetPosition();
+  this->backLeft.resetPosition();
+  this->backRight.resetPosition();
+}
+
+bool MecanumDriveTank::isStopped() {
+  return abs((int32_t) this->frontLeft.velocity(velocityUnits::pct)) < _MDT_H_STOPPED_VELOCITY
+      && abs((int32_t) this->frontRight.velocity(velocityUnits::pct)) < _MDT_H_STOPPED_VELOCITY
+      && abs((int32_t) this->backLeft.velocity(velocityUnits::pct)) < _MDT_H_STOPPED_VELOCITY
+      && abs((int32_t) this->backRight.velocity(velocityUnits::pct)) < _MDT_H_STOPPED_VELOCITY;
+}
+
+/*
+ * Forwards is the left-side wheels turning forwards and the right-side ones backwards,
+ * the same as `drive()` comes out with for a forward power.
+ */
+void MecanumDriveTank::setVoltage(double volts) {
+  for(int i = 0; i < 4; i++) this->lastPowers[i] = this->references[i] = 0;
+  batteryCompensation.spinVolts(this->frontLeft, volts);
+  batteryCompensation.spinVolts(this->frontRight, -volts);
+  batteryCompensation.spinVolts(this->backLeft, volts);
+  batteryCompensation.spinVolts(this->backRight, -volts);
+}
+
+double MecanumDriveTank::getSpeed() {
+  return ( this->frontLeft.velocity(velocityUnits::pct)
+         - this->frontRight.velocity(velocityUnits::pct)
+         + this->backLeft.velocity(velocityUnits::pct)
+         - this->backRight.velocity(velocityUnits::pct) ) / 4;
+}
+
+void MecanumDriveTank::getWheelPositions(double positions[4]) {
+  positions[0] = this->frontLeft.position(rotationUnits::rev);
+  positions[1] = this->frontRight.position(rotationUnits::rev);
+  positions[2] = this->backLeft.position(rotationUnits::rev);
+  positions[3] = this->backRight.position(rotationUnits::rev);
+}
+
+/*
+ * The references and last powers are left at the wheel speeds, so that handing the
+ * drive back to the sticks or `drive()` carries on smoothly from where the trajectory
+ * left it.
+ */
+void MecanumDriveTank::followWheels(const double speeds[4], const double accelerations[4], const double errors[4]) {
+  double dt = this->outputInterval();
+  if(this->traction) this->measureSlip(speeds, dt);
+  motor* motors[] = { &this->frontLeft, &this->frontRight, &this->backLeft, &this->backRight };
+  for(int i = 0; i < 4; i++) {
+    double speed = speeds[i] + this->config->followGain * errors[i];
+    batteryCompensation.spinVolts(*motors[i], this->config->driveModel.volts(speed, accelerations[i]));
+    this->references[i] = speeds[i];
+    this->lastPowers[i] = (int32_t) speeds[i];
+  }
+}
+
+void MecanumDriveTank::setLiftHeight(HeightInput height) {
+  this->liftHeight = height;
+}
+
+void MecanumDriveTank::useTractionControl(bool enabled) {
+  this->traction = enabled;
+  for(int i = 0; i < 4; i++) {
+    this->groundSpeeds[i] = this->slips[i] = 0;
+    this->shares[i] = 1;
+  }
+}
 
-  // Spin.
-  this->frontLeft.spin(forward);
-  this->frontRight.spin(forward);
-  this->backLeft.spin(forward);
-  this->backRight.spin(forward);
-}
\ No newline at end of file
+void MecanumDriveTank::getSlip(double slip[4]) {
+  for(int i = 0; i < 4; i++) slip[i] = this->slips[i];
+}
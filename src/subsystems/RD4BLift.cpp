@@ -21,6 +21,9 @@
  */
 
 #include "subsystems/RD4BLift.h"
+#include "MessageQueue.h"
+#include "Compensation.h"
+#include "Motors.h"
 
 /*
  * Assign all of the constructor parameters to the private internal variables,
@@ -29,19 +32,16 @@
  */
 
 RD4BLift::RD4BLift(AxisInput axisInput, int32_t leftMotorPort, int32_t rightMotorPort):
-    liftMotor0(leftMotorPort),
-    liftMotor1(rightMotorPort) {
+    liftMotor0(Motors::get(leftMotorPort)),
+    liftMotor1(Motors::get(rightMotorPort)) {
       this->manualInput = axisInput;
       this->groundInput = [](){return false;};
       this->lowerTowerInput = [](){return false;};
       this->upperTowerInput = [](){return false;};
-      this->liftMotor0.resetRotation();
-      this->liftMotor0.resetPosition();
-      this->liftMotor1.resetRotation();
-      this->liftMotor1.resetPosition();
-      this->liftMotor0.setBrake(brakeType::brake);
-      this->liftMotor1.setBrake(brakeType::brake);
       this->state = State::MANUAL;
+      this->reached = false;
+      this->reference = 0;
+      this->softLimits = true;
   }
 
 
@@ -55,14 +55,19 @@ RD4BLift::RD4BLift( AxisInput manualInput,
             ButtonInput upperTowerInput,
             int32_t leftMotorPort,
             int32_t rightMotorPort ):
-  liftMotor0(leftMotorPort),
-  liftMotor1(rightMotorPort) {
+  liftMotor0(Motors::get(leftMotorPort)),
+  liftMotor1(Motors::get(rightMotorPort)) {
   this->manualInput = manualInput;
   this->groundInput = groundInput;
   this->lowerTowerInput = lowerTowerInput;
   this->upperTowerInput = upperTowerInput;
   this->state = State::MANUAL;
+  this->reached = false;
+  this->reference = 0;
+  this->softLimits = true;
+}
 
+void RD4BLift::prepare() {
   // Don't know what the difference is, docs say the same thing, just using both in case
   this->liftMotor0.resetRotation();
   this->liftMotor0.resetPosition();
@@ -83,7 +88,7 @@ void RD4BLift::update() {
   // it has to take higher precedence over the automatic features.
 
   // If there is input, switch to the state the input is for
-  if(abs(this->manualInput()) > _RD4BLIFT_H_DBAND) {
+  if(abs(this->manualInput()) > this->config->liftDeadband) {
     this->state = State::MANUAL;
   } else if(this->groundInput()) {
     this->state = State::GROUND;
@@ -94,6 +99,22 @@ void RD4BLift::update() {
   }
 
   // Then execute the corresponding state function
+  this->runState();
+}
+
+void RD4BLift::setState(State state) {
+  this->state = state;
+}
+
+RD4BLift::State RD4BLift::getState() {
+  return this->state;
+}
+
+/*
+ * Calls the state function that matches the current state.  Split out of `update()` so
+ * that commands can hold the lift at a preset without any input being read.
+ */
+void RD4BLift::runState() {
   switch(this->state) {
     case State::MANUAL:      this->stateManual();
                              break;
@@ -104,6 +125,79 @@ void RD4BLift::update() {
     case State::UPPER_TOWER: this->stateUpperTower();
                              break;
   }
+
+  // Let the driver know once a preset has been reached, without them looking at the lift.
+  bool reached = this->state != State::MANUAL && this->atTarget();
+  if(reached && !this->reached) {
+    static const char* names[] = { "", "ground", "lower tower", "upper tower" };
+    controllerMessages.post(1, "Lift: %s", names[this->state]);
+    controllerMessages.rumble(".");
+  } else if(this->state == State::MANUAL && this->reached) {
+    controllerMessages.post(1, "Lift: manual");
+  }
+  this->reached = reached;
+}
+
+double RD4BLift::getHeight() {
+  return this->liftMotor0.position(rotationUnits::rev);
+}
+
+bool RD4BLift::atTarget() {
+  double target;
+  switch(this->state) {
+    case State::GROUND:      target = this->config->liftFloor;
+                             break;
+    case State::LOWER_TOWER: target = this->config->liftLowerTower;
+                             break;
+    case State::UPPER_TOWER: target = this->config->liftUpperTower;
+                             break;
+    default:                 return true;
+  }
+  double error = this->getHeight() - target;
+  return error < this->config->liftTolerance && error > -this->config->liftTolerance;
+}
+
+void RD4BLift::setVoltage(double volts) {
+  this->reference = 0;
+  batteryCompensation.spinVolts(this->liftMotor0, volts);
+  batteryCompensation.spinVolts(this->liftMotor1, -1 * volts);
+}
+
+void RD4BLift::stop(brakeType mode) {
+  this->reference = 0;
+  this->liftMotor0.stop(mode);
+  this->liftMotor1.stop(mode);
+}
+
+double RD4BLift::getSpeed() {
+  return this->liftMotor0.velocity(velocityUnits::pct);
+}
+
+/*
+ * The lift can stop in `v * v / (2 * decel)` (in percent-seconds, turned into
+ * revolutions by the free speed), so the fastest it can go with `room` left is the
+ * square root of `2 * decel * room`.  Going down, gravity works against the brakes,
+ * so it only gets a share of the deceleration.
+ */
+double RD4BLift::getSpeedLimit(double height, bool up) {
+  double room = up ? this->config->liftMaxHeight - height : height - this->config->liftFloor;
+  if(room <= 0) return 0;
+  room -= _RD4BLIFT_H_STOP_MARGIN;
+  double decel = this->config->liftStopDecel * (up ? 1 : _RD4BLIFT_H_DOWN_DECEL);
+  double limit = room <= 0 ? 0 : sqrt(2 * decel * room / (_RD4BLIFT_H_FREE_SPEED / 100));
+  return limit < _RD4BLIFT_H_CREEP_SPEED ? _RD4BLIFT_H_CREEP_SPEED : limit;
+}
+
+/*
+ * Nothing commanded now takes effect before the next tick, so the envelope is checked
+ * where the lift will be by then rather than where it is.
+ */
+double RD4BLift::getHeightAhead(double height, double speed, double dt) {
+  return height + speed * _RD4BLIFT_H_FREE_SPEED / 100 * dt;
+}
+
+void RD4BLift::useSoftLimits(bool enabled) {
+  this->softLimits = enabled;
 }
 
 /*
@@ -112,60 +206,84 @@ void RD4BLift::update() {
  * here as a safety and fallback feature.
  */
 void RD4BLift::stateManual() {
-  // TODO scale inputs??
-  //int32_t input = (abs(this->manualInput()) > _RD4BLIFT_H_DBAND) ? this->manualInput() : 0;
-
-  // Safety features: check to make sure the lift position isn't outside of the correct range;
-  // if it is, only allow it to move in the direction back to the correct range.
-  // if(this->liftMotor0.position(rotationUnits::raw) >= _RD4BLIFT_H_MAX_HEIGHT && input > 0) {
-  //   this->liftMotor0.stop(brakeType::brake);
-  //   this->liftMotor1.stop(brakeType::brake);
-  //   return;
-  // } else if(this->liftMotor0.position(rotationUnits::raw) <= 0 && input < 0) {
-  //   this->liftMotor0.stop(brakeType::brake);
-  //   this->liftMotor1.stop(brakeType::brake);
-  //   return;
-  // }
-
-  // Then pretty much directly apply the input to the motors as percent output.
-  this->liftMotor0.setVelocity(this->manualInput(), percent);
-  this->liftMotor1.setVelocity(-1 * this->manualInput(), percent);
-  this->liftMotor0.spin(forward);
-  this->liftMotor1.spin(forward);
+  // Pretty much directly apply the input to the motors as percent output.  With no
+  // input, hold where it is rather than let gravity take it down.
+  int32_t input = this->manualInput();
+  double dt = this->outputInterval();
+  if(abs(input) <= this->config->liftDeadband) {
+    this->liftMotor0.stop(brakeType::hold);
+    this->liftMotor1.stop(brakeType::hold);
+    this->reference = 0;
+    return;
+  }
+
+  // Near either end, the input is a power but the envelope is a speed, and gravity
+  // comes between the two; so once the input asks for more than the envelope allows,
+  // or the lift is already going faster than it either way, the motors' own velocity
+  // control takes over at the nearest speed inside it.
+  // Each end only matters when the input or the lift is heading towards it.
+  if(this->softLimits) {
+    double speed = this->getSpeed();
+    double height = this->getHeightAhead(this->getHeight(), speed, dt);
+    double up = input > 0 || speed > 0 ? this->getSpeedLimit(height, true) : 100;
+    double down = input < 0 || speed < 0 ? -this->getSpeedLimit(height, false) : -100;
+    if(input > up || input < down || speed > up || speed < down) {
+      double velocity = input > up ? up : input < down ? down : input;
+      this->reference = velocity;
+      if(velocity == 0) {
+        this->liftMotor0.stop(brakeType::hold);
+        this->liftMotor1.stop(brakeType::hold);
+        return;
+      }
+      this->liftMotor0.spin(directionType::fwd, velocity, velocityUnits::pct);
+      this->liftMotor1.spin(directionType::fwd, -1 * velocity, velocityUnits::pct);
+      return;
+    }
+  }
+
+  double volts = this->outputVolts(this->config->liftModel, input, this->reference, dt);
+  this->spinOutput(this->liftMotor0, volts);
+  this->spinOutput(this->liftMotor1, -1 * volts);
 }
 
 /*
  * Set the `RD4BLift` position to the lowermost position, and hold it there.
  */
 void RD4BLift::stateGround() {
-  this->liftMotor0.startRotateTo(_RD4BLIFT_H_FLOOR, rotationUnits::rev);
-  this->liftMotor1.startRotateTo(_RD4BLIFT_H_FLOOR, rotationUnits::rev);
-  // this->liftMotor0.setVelocity(20, percent);
-  // this->liftMotor1.setVelocity(20, percent);
-  // this->liftMotor0.spin(forward);
-  // this->liftMotor1.spin(forward);
+  this->moveTo(this->config->liftFloor);
 }
 
 /*
  * Set the `RD4BLift` position to the lower tower position, and hold it there.
  */
 void RD4BLift::stateLowerTower() {
-  this->liftMotor0.startRotateTo(_RD4BLIFT_H_LOWER_TOWER, rotationUnits::rev);
-  this->liftMotor1.startRotateTo(_RD4BLIFT_H_LOWER_TOWER, rotationUnits::rev);
-  // this->liftMotor0.setVelocity(40, percent);
-  // this->liftMotor1.setVelocity(40, percent);
-  // this->liftMotor0.spin(forward);
-  // this->liftMotor1.spin(forward);
+  this->moveTo(this->config->liftLowerTower);
 }
 
 /*
  * Set the `RD4BLift` position to the upper tower position, and hold it there.
  */
 void RD4BLift::stateUpperTower() {
-  // this->liftMotor0.startRotateTo(_RD4BLIFT_H_UPPER_TOWER, rotationUnits::raw);
-  // this->liftMotor1.startRotateTo(_RD4BLIFT_H_UPPER_TOWER, rotationUnits::raw);
-  this->liftMotor0.setVelocity(60, percent);
-  this->liftMotor1.setVelocity(60, percent);
-  this->liftMotor0.spin(forward);
-  this->liftMotor1.spin(forward);
+  this->moveTo(this->config->liftUpperTower);
+}
+
+/*
+ * The speed is passed explicitly because `startRotateTo()` otherwise reuses whatever
+ * velocity was last set, which after manual control is usually zero.  The right motor
+ * is mounted mirrored, so it has to turn the other way to reach the same height.
+ */
+void RD4BLift::moveTo(double height) {
+  double speed = this->config->liftPresetSpeed;
+  if(this->softLimits) {
+    // Presets are kept inside the travel, and approach the ends no faster than the
+    // envelope allows.
+    if(height > this->config->liftMaxHeight) height = this->config->liftMaxHeight;
+    if(height < this->config->liftFloor) height = this->config->liftFloor;
+    double ahead = this->getHeightAhead(this->getHeight(), this->getSpeed(), this->outputInterval());
+    double limit = this->getSpeedLimit(ahead, height > ahead);
+    if(limit < _RD4BLIFT_H_CREEP_SPEED) limit = _RD4BLIFT_H_CREEP_SPEED;
+    if(speed > limit) speed = limit;
+  }
+  this->liftMotor0.startRotateTo(height, rotationUnits::rev, speed, velocityUnits::pct);
+  this->liftMotor1.startRotateTo(-height, rotationUnits::rev, speed, velocityUnits::pct);
 }
@@ -21,15 +21,22 @@
  */
 
 #include "subsystems/RollerIntake.h"
+#include "MessageQueue.h"
+#include "Motors.h"
 
 RollerIntake::RollerIntake( ButtonInput inInput,
                             ButtonInput outInput,
                             int32_t leftMotorPort,
                             int32_t rightMotorPort ):
-  left(leftMotorPort),
-  right(rightMotorPort) {
+  left(Motors::get(leftMotorPort)),
+  right(Motors::get(rightMotorPort)) {
   this->inInput = inInput;
   this->outInput = outInput;
+  this->stalledTicks = 0;
+  this->reference = 0;
+}
+
+void RollerIntake::prepare() {
   this->left.setBrake(brakeType::hold);
   this->right.setBrake(brakeType::hold);
 }
@@ -37,19 +44,48 @@ RollerIntake::RollerIntake( ButtonInput inInput,
 void RollerIntake::update() {
   // if both buttons are pressed, no power is supplied. if both are pressed, then they cancel out
   if(inInput() == outInput()) {
-    this->right.setVelocity(0, percent);
-    this->left.setVelocity(0, percent);
-    this->right.spin(forward);
-    this->left.spin(forward);
+    this->spin(0);
   } else if(outInput()) {
-    this->right.setVelocity(_ROLLER_H_POWER, percent);
-    this->left.setVelocity(-1 * _ROLLER_H_POWER, percent);
-    this->right.spin(forward);
-    this->left.spin(forward);
+    this->spin(-1 * this->config->rollerPower);
+  } else {
+    this->spin(this->config->rollerPower);
+  }
+}
+
+// The two rollers face each other, so the right one always turns the opposite way.
+// With no power, they hold where they are (see `prepare()`) rather than go limp.
+void RollerIntake::spin(int32_t power) {
+  if(power == 0) {
+    this->left.stop();
+    this->right.stop();
+    this->reference = 0;
+  } else {
+    double volts = this->outputVolts(this->config->rollerModel, power, this->reference, this->outputInterval());
+    this->spinOutput(this->left, volts);
+    this->spinOutput(this->right, -1 * volts);
+  }
+
+  // Watch for a jam, and tell the driver when the rollers get stuck or come free.
+  bool stalled = power != 0 && abs((int32_t) this->left.velocity(velocityUnits::pct)) < _ROLLER_H_JAM_SPEED;
+  if(stalled) {
+    if(++this->stalledTicks == _ROLLER_H_JAM_TICKS) {
+      controllerMessages.post(2, "Intake jammed");
+      controllerMessages.rumble("--");
+    }
   } else {
-    this->right.setVelocity(-1 * _ROLLER_H_POWER, percent);
-    this->left.setVelocity(_ROLLER_H_POWER, percent);
-    this->right.spin(forward);
-    this->left.spin(forward);
+    if(this->stalledTicks >= _ROLLER_H_JAM_TICKS) controllerMessages.post(2, "");
+    this->stalledTicks = 0;
   }
-}
\ No newline at end of file
+}
+
+bool RollerIntake::isJammed() {
+  return this->stalledTicks >= _ROLLER_H_JAM_TICKS;
+}
+
+double RollerIntake::getSpeed() {
+  return this->left.velocity(velocityUnits::pct);
+}
+
+double RollerIntake::getRotation() {
+  return this->left.position(rotationUnits::rev);
+}